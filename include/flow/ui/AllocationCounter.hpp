@@ -0,0 +1,89 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+FLOW_UI_NAMESPACE_START
+
+/**
+ * @brief Counts one heap allocation, called by the allocation functions that FLOW_UI_COUNT_ALLOCATIONS defines.
+ * @note Can be called from any thread, including while static objects are being initialised.
+ */
+void CountAllocation() noexcept;
+
+/**
+ * @brief Gets the number of heap allocations counted since the program started.
+ * @returns The number of allocations.
+ */
+std::size_t GetAllocationCount() noexcept;
+
+/**
+ * @brief Checks that frames in a steady state, such as those of an idle editor, do not allocate.
+ *
+ * Allocations are only counted once an executable replaces the global allocation functions with
+ * FLOW_UI_COUNT_ALLOCATIONS, since a shared library cannot portably replace them. Without it every frame counts zero.
+ */
+class AllocationCounter
+{
+  public:
+    /// Called with the number of allocations made by a steady state frame.
+    using RegressionHandler = std::function<void(std::size_t allocations)>;
+
+    /**
+     * @brief Constructs an allocation counter whose regression handler logs an error and asserts in debug builds.
+     * @param settle_frames The number of steady frames in a row that may still allocate, e.g. while caches fill.
+     */
+    explicit AllocationCounter(std::size_t settle_frames = 10);
+
+    /**
+     * @brief Ends a frame, calling the regression handler if a settled steady state frame allocated.
+     * @param steady Whether the frame is expected not to allocate, e.g. because there was no input or activity.
+     * @returns The number of allocations made during the frame.
+     */
+    std::size_t EndFrame(bool steady);
+
+    /**
+     * @brief Sets the function called when a steady state frame allocates, e.g. to fail a test.
+     * @param handler The regression handler.
+     */
+    void SetRegressionHandler(RegressionHandler handler) { _on_regression = std::move(handler); }
+
+  private:
+    std::size_t _settle_frames;
+    std::size_t _steady_frames    = 0;
+    std::size_t _last_allocations = 0;
+    RegressionHandler _on_regression;
+};
+
+/**
+ * @brief Get the global allocation counter, whose frames are ended by the editor.
+ * @returns The global allocation counter.
+ */
+AllocationCounter& GetAllocationCounter();
+
+FLOW_UI_NAMESPACE_END
+
+/**
+ * @brief Replaces the global allocation functions with ones that count every allocation.
+ *
+ * Use once at namespace scope in the executable. On Windows only allocations made through the executable's runtime
+ * are counted.
+ */
+// clang-format off
+#define FLOW_UI_COUNT_ALLOCATIONS()                                                                                    \
+    void* operator new(std::size_t size)                                                                               \
+    {                                                                                                                  \
+        ::flow::ui::CountAllocation();                                                                                 \
+        if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;                                                 \
+        throw std::bad_alloc();                                                                                        \
+    }                                                                                                                  \
+    void operator delete(void* ptr) noexcept { std::free(ptr); }                                                       \
+    void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+// clang-format on
@@ -0,0 +1,92 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+FLOW_UI_NAMESPACE_START
+
+/**
+ * @brief Fixed size histogram of latencies with power of two buckets.
+ *
+ * Bucket i counts latencies below 2^i microseconds that did not fit in an earlier bucket, with the last bucket holding
+ * everything larger. Recording is lock-free so it can be done from any worker thread.
+ */
+class LatencyHistogram
+{
+  public:
+    /// The number of buckets in the histogram.
+    static constexpr std::size_t BucketCount = 32;
+
+    /// A copy of the bucket counts.
+    using Buckets = std::array<std::uint64_t, BucketCount>;
+
+    /**
+     * @brief Records a latency.
+     * @param latency The latency to record.
+     */
+    void Record(std::chrono::nanoseconds latency) noexcept;
+
+    /**
+     * @brief Takes a copy of the bucket counts.
+     * @returns The number of latencies recorded in each bucket.
+     */
+    Buckets Snapshot() const noexcept;
+
+    /**
+     * @brief Clears all recorded latencies.
+     */
+    void Reset() noexcept;
+
+    /**
+     * @brief Gets the upper bound of a bucket.
+     * @param bucket The index of the bucket.
+     * @returns The largest latency counted by the bucket.
+     */
+    static std::chrono::microseconds BucketUpperBound(std::size_t bucket) noexcept;
+
+    /**
+     * @brief Estimates a percentile from a snapshot, rounded up to the upper bound of the bucket it falls in.
+     * @param buckets The snapshot of the bucket counts.
+     * @param percentile The percentile to get, between 0 and 1.
+     * @returns The estimated latency, zero if nothing was recorded.
+     */
+    static std::chrono::microseconds Percentile(const Buckets& buckets, double percentile) noexcept;
+
+  private:
+    std::array<std::atomic<std::uint64_t>, BucketCount> _buckets{};
+};
+
+/**
+ * @brief Compute timings of a single node, written by the threads running the node and read by the UI.
+ */
+struct NodeComputeStats
+{
+    /// Latency from the start of a compute to its first output or error.
+    LatencyHistogram Latency;
+
+    /// The number of times the node has been computed.
+    std::atomic<std::uint64_t> Calls = 0;
+
+    /// The start time of the pending compute in steady clock nanoseconds, 0 if there is none.
+    std::atomic<std::int64_t> ComputeStart = 0;
+
+    /**
+     * @brief Marks the start of a compute.
+     */
+    void BeginCompute() noexcept;
+
+    /**
+     * @brief Marks the end of the pending compute, recording its latency if this is the first end since it started.
+     */
+    void EndCompute() noexcept;
+};
+
+FLOW_UI_NAMESPACE_END
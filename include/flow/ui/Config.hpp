@@ -5,6 +5,8 @@
 
 #include "Core.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -49,6 +51,17 @@ enum class RendererBackend
     DirectX12,
 };
 
+/**
+ * @brief What the node header heatmap overlay shows.
+ */
+enum class NodeHeatmapMode : std::uint8_t
+{
+    None,
+    LatencyP50,
+    LatencyP99,
+    CallRate,
+};
+
 /**
  * @brief Configuration details for the editor.
  */
@@ -58,6 +71,42 @@ struct Config
     std::unique_ptr<Font> IconFont;
     std::unique_ptr<Font> NodeHeaderFont;
     RendererBackend RenderBackend = RendererBackend::FirstAvailable;
+
+    /// Maximum number of bytes of a formatted value shown before it is truncated.
+    std::size_t ValuePreviewMaxBytes = 1024;
+
+    /// Maximum number of lines of a formatted value shown before it is truncated.
+    std::size_t ValuePreviewMaxLines = 16;
+
+    /// What node headers are tinted by.
+    NodeHeatmapMode NodeHeatmap = NodeHeatmapMode::None;
+
+    /// Compute latency in milliseconds that is shown as the hottest heatmap colour.
+    float NodeHeatmapMaxLatency = 100.f;
+
+    /// Computes per second that are shown as the hottest heatmap colour.
+    float NodeHeatmapMaxCallRate = 100.f;
+
+    /// Minimum number of seconds between flow animations of a busy link.
+    double LinkFlowInterval = 0.25;
+
+    /// Whether the editor lowers its frame rate while there is no input or runtime activity.
+    bool AdaptiveFramePacing = true;
+
+    /// Frames per second drawn while the editor is idle.
+    float IdleFrameRate = 4.f;
+
+    /// Seconds the editor keeps drawing at full rate after runtime activity such as node outputs or errors.
+    float ActiveFrameTime = 0.5f;
+
+    /// Seconds a changed module file has to be left untouched before hot reload picks it up.
+    float ModuleReloadDelay = 0.5f;
+
+    /// Number of parallel jobs module projects are built with, 0 uses one per CPU.
+    std::size_t ModuleBuildJobs = 0;
+
+    /// CPUs the render thread is pinned to, one bit per CPU. Graph executors avoid them. 0 leaves it unpinned.
+    std::uint64_t RenderThreadAffinity = 0;
 };
 
 /**
@@ -4,7 +4,10 @@
 #pragma once
 
 #include "Config.hpp"
+#include "Executor.hpp"
 #include "FileExplorer.hpp"
+#include "FrameArena.hpp"
+#include "SessionRecorder.hpp"
 #include "Style.hpp"
 #include "ViewFactory.hpp"
 #include "Window.hpp"
@@ -81,6 +84,24 @@ class Editor
      */
     void* GetContext() const noexcept;
 
+    /**
+     * @brief Records the input of the session, starting from the flow that is open once the editor is initialised.
+     * @param file The file the recording is written to when recording stops or the editor exits.
+     */
+    void RecordSession(std::filesystem::path file);
+
+    /**
+     * @brief Replays a recorded session, opening the recorded flow instead of the initial file.
+     * @param file The recording to replay.
+     * @param pace How fast to replay the recorded frames.
+     */
+    void ReplaySession(std::filesystem::path file, ReplayPace pace = ReplayPace::Recorded);
+
+    /**
+     * @brief Asks the editor to close at the end of the current frame.
+     */
+    void RequestExit();
+
     /**
      * @brief Event that is run to load custom fonts for the editor.
      */
@@ -91,6 +112,16 @@ class Editor
      */
     Event<Style&> SetupStyle = [](auto&) {};
 
+    /**
+     * @brief Event that is run at the start of every frame, before any input is handled or windows are drawn.
+     */
+    Event<> OnNewFrame = [] {};
+
+    /**
+     * @brief Event that is run with the frame time statistics once a replayed session is finished.
+     */
+    Event<const ReplayStats&> OnReplayFinished = [](const auto&) {};
+
     /**
      * @brief Event dispatcher that is run every time a new graph is marked as the active graph.
      */
@@ -104,10 +135,16 @@ class Editor
 
     void DrawMainMenuBar();
 
-    std::shared_ptr<GraphWindow>& CreateFlow(std::string name);
+    std::shared_ptr<GraphWindow>& CreateFlow(std::string name, const ExecutorSettings& executor = {});
     void LoadFlow(const std::filesystem::path& file = "");
     void SaveFlow();
 
+    void ChangeExecutor(const std::shared_ptr<GraphWindow>& graph_window, const ExecutorSettings& settings);
+
+    void StartRecording();
+    void StopRecording();
+    void StartReplay();
+
   private:
     std::shared_ptr<ViewFactory> _factory = std::make_shared<ViewFactory>();
     std::shared_ptr<Env> _env             = Env::Create(_factory);
@@ -116,6 +153,12 @@ class Editor
     std::unordered_map<UUID, std::shared_ptr<GraphWindow>> _graph_windows;
     EventDispatcher<> OnGraphWindowAdded;
     EventDispatcher<> OnGraphWindowRemoved;
+
+    std::filesystem::path _session_file;
+    ReplayPace _replay_pace = ReplayPace::Recorded;
+    bool _replay_session    = false;
+    std::unique_ptr<SessionRecorder> _recorder;
+    std::unique_ptr<SessionReplayer> _replayer;
 };
 
 FLOW_UI_NAMESPACE_END
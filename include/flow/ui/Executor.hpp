@@ -0,0 +1,153 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+#include "Style.hpp"
+
+#include <flow/core/Env.hpp>
+#include <flow/core/Graph.hpp>
+#include <flow/core/NodeFactory.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+FLOW_UI_NAMESPACE_START
+
+using json = nlohmann::json;
+
+/**
+ * @brief Scheduling priority of executor threads relative to the rest of the process.
+ */
+enum class ThreadPriority : std::uint8_t
+{
+    Low,
+    Normal,
+    High,
+};
+
+/**
+ * @brief A named set of worker threads that nodes of a graph can be assigned to, isolating them from the rest.
+ */
+struct ExecutionLane
+{
+    /// The name nodes refer to the lane by.
+    std::string Name;
+
+    /// Number of worker threads, 1 makes the lane a serial queue.
+    std::size_t Threads = 1;
+
+    /// Scheduling priority of the worker threads.
+    ThreadPriority Priority = ThreadPriority::Normal;
+
+    /// The colour of the band drawn on the headers of the lane's nodes.
+    Colour BandColour = Colour(230, 160, 40);
+
+    bool operator==(const ExecutionLane&) const = default;
+};
+
+/**
+ * @brief How the nodes of a graph are executed.
+ */
+struct ExecutorSettings
+{
+    /// Number of worker threads of the graph's own executor, 0 uses the editor's shared executor.
+    std::size_t Threads = 0;
+
+    /// Scheduling priority of the worker threads.
+    ThreadPriority Priority = ThreadPriority::Normal;
+
+    /// CPUs the worker threads may run on, one bit per CPU. 0 allows every CPU not reserved for the render thread.
+    std::uint64_t AffinityMask = 0;
+
+    /// Lanes that nodes can be assigned to, which share the affinity mask but have their own threads.
+    std::vector<ExecutionLane> Lanes;
+
+    bool operator==(const ExecutorSettings&) const = default;
+};
+
+void to_json(json& j, const ExecutionLane& lane);
+void from_json(const json& j, ExecutionLane& lane);
+
+void to_json(json& j, const ExecutorSettings& settings);
+void from_json(const json& j, ExecutorSettings& settings);
+
+/**
+ * @brief Gets the number of CPUs that can be used in affinity masks.
+ * @returns The number of CPUs, at most 64.
+ */
+std::size_t GetCPUCount() noexcept;
+
+/**
+ * @brief Applies an affinity mask and priority to the calling thread.
+ *
+ * @param affinity_mask The CPUs the thread may run on, 0 leaves the affinity unchanged.
+ * @param priority The scheduling priority of the thread.
+ *
+ * @returns true if the settings were applied, false if the platform does not support them or refused them.
+ */
+bool SetCurrentThreadScheduling(std::uint64_t affinity_mask, ThreadPriority priority) noexcept;
+
+/**
+ * @brief Applies an affinity mask and priority to every worker thread of an environment.
+ *
+ * Workers are pinned to the affinity mask minus Config::RenderThreadAffinity. The environment must be idle, as a task
+ * is run on each worker and waited for.
+ *
+ * @param env The environment whose workers to apply the settings to.
+ * @param workers The number of worker threads of the environment.
+ * @param affinity_mask The CPUs the workers may run on, 0 for every CPU not reserved for the render thread.
+ * @param priority The scheduling priority of the workers.
+ *
+ * @returns true if the settings were applied to every worker, false otherwise.
+ */
+bool SetExecutorScheduling(flow::Env& env, std::size_t workers, std::uint64_t affinity_mask, ThreadPriority priority);
+
+/**
+ * @brief Creates an environment with its own worker threads.
+ *
+ * Every worker is pinned to the settings' affinity mask, minus Config::RenderThreadAffinity, and given its priority.
+ *
+ * @param factory The node factory shared with the editor.
+ * @param settings The executor settings, must have at least one thread.
+ *
+ * @returns The new environment.
+ */
+std::shared_ptr<flow::Env> CreateExecutor(std::shared_ptr<flow::NodeFactory> factory, const ExecutorSettings& settings);
+
+/**
+ * @brief Creates the environment of an execution lane.
+ *
+ * @param factory The node factory shared with the editor.
+ * @param settings The executor settings the lane belongs to, whose affinity mask the lane shares.
+ * @param lane The lane to create the environment of.
+ *
+ * @returns The new environment.
+ */
+std::shared_ptr<flow::Env> CreateLaneExecutor(std::shared_ptr<flow::NodeFactory> factory,
+                                              const ExecutorSettings& settings, const ExecutionLane& lane);
+
+/**
+ * @brief Moves a node of a graph to another environment, e.g. the executor of an execution lane.
+ *
+ * A node runs on the environment it was created with, so it is replaced by a copy with the same ID, name and state,
+ * and its connections are made again. The copy is not started.
+ *
+ * @param graph The graph the node belongs to.
+ * @param node The node to move.
+ * @param env The environment to move the node to.
+ * @param remove_node Removes the stopped node from the graph once its copy is created, RemoveNodeByID if empty.
+ *
+ * @returns The copy of the node.
+ * @throws std::runtime_error if the node cannot be recreated, in which case the graph is left unchanged.
+ */
+flow::SharedNode MoveNodeToEnv(flow::Graph& graph, const flow::SharedNode& node, std::shared_ptr<flow::Env> env,
+                               const std::function<void(const flow::SharedNode&)>& remove_node = {});
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,109 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+FLOW_UI_NAMESPACE_START
+
+/**
+ * @brief Bump allocator for temporaries that only need to live until the end of the current frame.
+ *
+ * Allocations are carved out of a single block that is rewound at the start of every frame. If a frame needs more than
+ * the block holds, the rest is taken from the heap and the block is grown to fit on the next reset, so a UI in a steady
+ * state stops allocating after the first few frames.
+ *
+ * @note The arena is not thread safe and must only be used from the render thread.
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+  public:
+    /**
+     * @brief Constructs a frame arena.
+     * @param initial_capacity The initial size of the block in bytes.
+     */
+    explicit FrameArena(std::size_t initial_capacity = 64 * 1024);
+
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Releases everything allocated since the last reset.
+     * @note Any memory handed out before the reset must no longer be in use.
+     */
+    void Reset();
+
+    /**
+     * @brief Gets the size of the block allocations are served from.
+     * @returns The capacity in bytes.
+     */
+    std::size_t Capacity() const noexcept { return _capacity; }
+
+    /**
+     * @brief Gets the number of bytes allocated since the last reset, including any that overflowed to the heap.
+     * @returns The number of bytes used.
+     */
+    std::size_t BytesUsed() const noexcept { return _used; }
+
+  protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  private:
+    struct Overflow
+    {
+        void* Data;
+        std::size_t Alignment;
+    };
+
+    std::unique_ptr<std::byte[]> _block;
+    std::size_t _capacity;
+    std::size_t _offset = 0;
+    std::size_t _used   = 0;
+    std::vector<Overflow> _overflow;
+};
+
+/// String that allocates from the frame arena.
+using FrameString = std::pmr::string;
+
+/// Vector that allocates from the frame arena.
+template<typename T>
+using FrameVector = std::pmr::vector<T>;
+
+/**
+ * @brief Get the global frame arena, reset by the editor at the start of every frame.
+ * @returns The global frame arena.
+ */
+FrameArena& GetFrameArena();
+
+/**
+ * @brief Formats text into the frame arena, e.g. for building widget IDs without a heap allocation.
+ * @param format The fmt format string.
+ * @param args The format arguments.
+ * @returns The null terminated formatted text, valid until the end of the frame.
+ */
+template<typename... Args>
+const char* FrameFormat(fmt::format_string<Args...> format, Args&&... args)
+{
+    const std::size_t size = fmt::formatted_size(format, args...);
+    auto* text             = static_cast<char*>(GetFrameArena().allocate(size + 1, alignof(char)));
+
+    fmt::format_to_n(text, size, format, std::forward<Args>(args)...);
+    text[size] = '\0';
+
+    return text;
+}
+
+FLOW_UI_NAMESPACE_END
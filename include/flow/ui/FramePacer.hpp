@@ -0,0 +1,63 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+FLOW_UI_NAMESPACE_START
+
+/**
+ * @brief Decides when the editor can lower its frame rate and wakes it when something changes.
+ *
+ * The render loop idles between frames while there is no input and nothing asked it to stay active. Runtime activity
+ * from any thread, such as node outputs, errors or finished background work, wakes it immediately and keeps it at full
+ * rate for a short while.
+ */
+class FramePacer
+{
+    using Clock = std::chrono::steady_clock;
+
+  public:
+    /**
+     * @brief Wakes the render loop and keeps it at full rate for Config::ActiveFrameTime seconds.
+     * @note Can be called from any thread.
+     */
+    void Wake() noexcept;
+
+    /**
+     * @brief Wakes the render loop and keeps it at full rate for at least the given time, used while animations run.
+     * @param seconds How long to keep drawing at full rate.
+     * @note Can be called from any thread.
+     */
+    void KeepActive(float seconds) noexcept;
+
+    /**
+     * @brief Marks the start of a frame.
+     * @returns true if the render loop may idle after this frame, false if it must keep drawing at full rate.
+     * @note Must only be called from the render thread.
+     */
+    bool BeginFrame() noexcept;
+
+  private:
+    std::int64_t Now() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+  private:
+    std::atomic<std::int64_t> _active_until{0};
+    std::atomic_bool _may_idle{false};
+};
+
+/**
+ * @brief Get the global frame pacer.
+ * @returns The global frame pacer.
+ */
+FramePacer& GetFramePacer();
+
+FLOW_UI_NAMESPACE_END
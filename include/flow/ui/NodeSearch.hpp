@@ -0,0 +1,87 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+#include "FrameArena.hpp"
+
+#include <flow/core/NodeFactory.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+FLOW_UI_NAMESPACE_START
+
+/**
+ * @brief Searches the registered node classes for the node creation menus.
+ *
+ * Matches are collected into the frame arena instead of copying the category map, and friendly names are cached per
+ * class so listing the nodes does not allocate every frame.
+ */
+class NodeSearch
+{
+  public:
+    /// A category and class name pair of a registered node class.
+    using Entry = flow::CategoryMap::value_type;
+
+    /**
+     * @brief Finds the node classes whose class name or friendly name contain the search string, ignoring case.
+     *
+     * @param factory The factory the node classes are registered to.
+     * @param lookup The string to search for. Every class matches if empty.
+     *
+     * @returns The matching entries sorted by category, valid until the end of the frame.
+     */
+    FrameVector<const Entry*> Filter(const NodeFactory& factory, std::string_view lookup);
+
+    /**
+     * @brief Gets the friendly name of a node class.
+     *
+     * @param factory The factory the node class is registered to.
+     * @param class_name The class name of the node.
+     *
+     * @returns The cached friendly name.
+     */
+    const std::string& GetFriendlyName(const NodeFactory& factory, const std::string& class_name);
+
+    /**
+     * @brief Splits filtered entries into runs of the same category.
+     *
+     * @param entries The filtered entries, sorted by category.
+     * @param func The function to call with the category name and its entries.
+     */
+    template<typename F>
+    static void ForEachCategory(std::span<const Entry* const> entries, F&& func)
+    {
+        while (!entries.empty())
+        {
+            const std::string& category = entries.front()->first;
+
+            std::size_t count = 1;
+            while (count < entries.size() && entries[count]->first == category)
+            {
+                ++count;
+            }
+
+            func(category, entries.first(count));
+            entries = entries.subspan(count);
+        }
+    }
+
+  private:
+    struct NameHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    std::unordered_map<std::string, std::string, NameHash, std::equal_to<>> _friendly_names;
+    std::size_t _class_count = 0;
+};
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,194 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+FLOW_UI_NAMESPACE_START
+
+/**
+ * @brief A single timed scope recorded by the profiler.
+ */
+struct ProfileEvent
+{
+    /// The name of the scope, always a string with static lifetime or one interned by the profiler.
+    const char* Name = nullptr;
+
+    /// The start time of the scope in nanoseconds since the profiler was created.
+    std::int64_t Start = 0;
+
+    /// The end time of the scope in nanoseconds since the profiler was created.
+    std::int64_t End = 0;
+
+    /// The profiler assigned ID of the thread the scope ran on.
+    std::uint32_t ThreadID = 0;
+};
+
+/**
+ * @brief Records timed scopes into a fixed size lock-free ring buffer.
+ *
+ * Any thread can record events. Each slot is guarded by a sequence number so readers can take a consistent snapshot
+ * while writers keep going, skipping slots that were overwritten mid-read. Once the buffer is full the oldest events
+ * are overwritten.
+ */
+class Profiler
+{
+  public:
+    /// The number of events kept in the ring buffer, must be a power of two.
+    static constexpr std::size_t Capacity = std::size_t{1} << 17;
+
+    /// The number of frame times kept for the frame time graph.
+    static constexpr std::size_t FrameHistory = 300;
+
+    Profiler();
+
+    /**
+     * @brief Gets the current time on the profiler's clock.
+     * @returns The time in nanoseconds since the profiler was created.
+     */
+    std::int64_t Now() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+    }
+
+    /**
+     * @brief Records a timed scope.
+     * @param name The name of the scope. Must outlive the profiler.
+     * @param start The start time of the scope.
+     * @param end The end time of the scope.
+     */
+    void Record(const char* name, std::int64_t start, std::int64_t end) noexcept;
+
+    /**
+     * @brief Marks the start of a new frame, recording the duration of the previous one.
+     * @note Must only be called from the render thread.
+     */
+    void BeginFrame() noexcept;
+
+    /**
+     * @brief Copies a name into storage owned by the profiler so it can be used as a scope name.
+     * @param name The name to intern.
+     * @returns A pointer to the interned null terminated name.
+     */
+    const char* Intern(std::string_view name);
+
+    /**
+     * @brief Calls a function with every event that ended at or after the given time, oldest first.
+     * @param since The earliest end time to include.
+     * @param func The function to call with each event.
+     */
+    template<typename F>
+    void Visit(std::int64_t since, F&& func) const
+    {
+        const std::uint64_t head  = _head.load(std::memory_order_acquire);
+        const std::uint64_t first = head > Capacity ? head - Capacity : 0;
+
+        for (std::uint64_t i = first; i < head; ++i)
+        {
+            ProfileEvent event;
+            if (Read(i, event) && event.End >= since)
+            {
+                func(event);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the recorded frame durations, stored as a ring starting at GetFrameOffset.
+     * @returns The frame durations in milliseconds.
+     */
+    const std::array<float, FrameHistory>& GetFrameTimes() const noexcept { return _frame_times; }
+
+    /**
+     * @brief Gets the index of the oldest entry in the frame times.
+     * @returns The offset of the oldest frame time.
+     */
+    std::size_t GetFrameOffset() const noexcept { return _frame_index % FrameHistory; }
+
+    /**
+     * @brief Writes the events of the last few seconds in the Chrome trace event format.
+     * @param seconds How many seconds of events to include.
+     * @returns The trace as a JSON string.
+     */
+    std::string ExportChromeTrace(double seconds) const;
+
+  private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> Sequence{0};
+        std::atomic<const char*> Name{nullptr};
+        std::atomic<std::int64_t> Start{0};
+        std::atomic<std::int64_t> End{0};
+        std::atomic<std::uint32_t> ThreadID{0};
+    };
+
+    bool Read(std::uint64_t index, ProfileEvent& event) const noexcept;
+
+  private:
+    const std::chrono::steady_clock::time_point _epoch;
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<std::uint64_t> _head{0};
+
+    std::int64_t _frame_start = 0;
+    std::size_t _frame_index  = 0;
+    std::array<float, FrameHistory> _frame_times{};
+
+    std::mutex _names_mutex;
+    std::deque<std::string> _names;
+};
+
+/**
+ * @brief Get the global profiler.
+ * @returns The global profiler.
+ */
+Profiler& GetProfiler();
+
+/**
+ * @brief Records the time between its construction and destruction with the global profiler.
+ */
+class ProfileScope
+{
+  public:
+    /**
+     * @brief Starts timing a scope.
+     * @param name The name of the scope. Must outlive the profiler.
+     */
+    explicit ProfileScope(const char* name) noexcept : _name{name}, _start{GetProfiler().Now()} {}
+
+    ~ProfileScope() noexcept
+    {
+        auto& profiler = GetProfiler();
+        profiler.Record(_name, _start, profiler.Now());
+    }
+
+    ProfileScope(const ProfileScope&)            = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    const char* _name;
+    std::int64_t _start;
+};
+
+FLOW_UI_NAMESPACE_END
+
+#define FLOW_UI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define FLOW_UI_PROFILE_CONCAT(a, b) FLOW_UI_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef FLOW_UI_ENABLE_PROFILER
+#define FLOW_UI_PROFILE_SCOPE(name) ::flow::ui::ProfileScope FLOW_UI_PROFILE_CONCAT(_profile_scope_, __LINE__)(name)
+#else
+#define FLOW_UI_PROFILE_SCOPE(name) (void)0
+#endif
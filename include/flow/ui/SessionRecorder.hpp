@@ -0,0 +1,236 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+struct ImGuiContext;
+
+FLOW_UI_NAMESPACE_START
+
+using json = nlohmann::json;
+
+/**
+ * @brief A single input event, mirroring the events ImGui queues from the platform backend.
+ */
+struct RecordedInput
+{
+    /**
+     * @brief The kind of input event.
+     */
+    enum class Kind : std::uint8_t
+    {
+        MousePos,
+        MouseWheel,
+        MouseButton,
+        MouseViewport,
+        Key,
+        Text,
+        Focus,
+    };
+
+    /// The kind of input event.
+    Kind Type = Kind::MousePos;
+
+    /// The mouse source of mouse events.
+    std::uint8_t Source = 0;
+
+    /// The mouse button, key, character, viewport ID or focus state, depending on the kind.
+    std::uint32_t Code = 0;
+
+    /// The mouse position or wheel on the X axis, or the analog value of keys.
+    float X = 0.f;
+
+    /// The mouse position or wheel on the Y axis.
+    float Y = 0.f;
+
+    /// Whether a mouse button or key was pressed.
+    bool Down = false;
+};
+
+/**
+ * @brief The input of a single recorded frame.
+ */
+struct RecordedFrame
+{
+    /// The time since the previous frame in seconds.
+    float DeltaTime = 0.f;
+
+    /// The input events queued for the frame.
+    std::vector<RecordedInput> Events;
+};
+
+/**
+ * @brief A recorded editor session, the flow it started from and the input of every frame.
+ */
+struct SessionRecording
+{
+    /// The name of the flow that was open.
+    std::string FlowName;
+
+    /// The flow that was open when recording started.
+    json Flow;
+
+    /// The display width when recording started.
+    float DisplayWidth = 0.f;
+
+    /// The display height when recording started.
+    float DisplayHeight = 0.f;
+
+    /// The recorded frames.
+    std::vector<RecordedFrame> Frames;
+
+    /**
+     * @brief Writes the recording to a compact binary file.
+     * @param file The file to write to.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void Save(const std::filesystem::path& file) const;
+
+    /**
+     * @brief Reads a recording written by Save.
+     * @param file The file to read.
+     * @returns The recording.
+     * @throws std::runtime_error if the file cannot be read or is not a recording.
+     */
+    static SessionRecording Load(const std::filesystem::path& file);
+};
+
+/**
+ * @brief Records the input of every frame of an ImGui context.
+ *
+ * Events are captured from a context hook at the start of every frame, before ImGui processes them.
+ */
+class SessionRecorder
+{
+  public:
+    /**
+     * @brief Starts recording.
+     *
+     * @param ctx The ImGui context to record.
+     * @param flow_name The name of the flow that is open.
+     * @param flow The flow that is open, so a replay can start from the same graph.
+     */
+    SessionRecorder(ImGuiContext* ctx, std::string flow_name, json flow);
+
+    ~SessionRecorder();
+
+    SessionRecorder(const SessionRecorder&)            = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    /**
+     * @brief Gets the recording so far.
+     * @returns The recording.
+     */
+    const SessionRecording& GetRecording() const noexcept { return _recording; }
+
+  private:
+    void RecordFrame();
+
+  private:
+    ImGuiContext* _ctx;
+    std::uint32_t _hook_id       = 0;
+    std::uint32_t _last_event_id = 0;
+    SessionRecording _recording;
+};
+
+/**
+ * @brief How fast recorded frames are replayed.
+ */
+enum class ReplayPace : std::uint8_t
+{
+    /// Every frame lasts at least as long as it did when recorded.
+    Recorded,
+
+    /// Frames are replayed back to back.
+    Unthrottled,
+};
+
+/**
+ * @brief Frame time statistics of a replay, excluding the time spent waiting to match the recorded pace.
+ */
+struct ReplayStats
+{
+    /// Number of replayed frames.
+    std::size_t Frames = 0;
+
+    /// Mean frame time in milliseconds.
+    double Mean = 0.0;
+
+    /// Median frame time in milliseconds.
+    double P50 = 0.0;
+
+    /// 95th percentile frame time in milliseconds.
+    double P95 = 0.0;
+
+    /// 99th percentile frame time in milliseconds.
+    double P99 = 0.0;
+
+    /// Longest frame time in milliseconds.
+    double Max = 0.0;
+};
+
+void to_json(json& j, const ReplayStats& stats);
+
+/**
+ * @brief Feeds recorded input back into an ImGui context, one recorded frame per frame.
+ *
+ * The delta time of every frame is replaced with the recorded one and any live input is dropped, so the replay is
+ * deterministic regardless of how fast it runs. Replayed events that ImGui holds back for a later frame are kept.
+ */
+class SessionReplayer
+{
+    using Clock = std::chrono::steady_clock;
+
+  public:
+    /**
+     * @brief Starts replaying from the next frame.
+     *
+     * @param ctx The ImGui context to replay into.
+     * @param recording The recording to replay.
+     * @param pace How fast to replay the frames.
+     */
+    SessionReplayer(ImGuiContext* ctx, SessionRecording recording, ReplayPace pace);
+
+    ~SessionReplayer();
+
+    SessionReplayer(const SessionReplayer&)            = delete;
+    SessionReplayer& operator=(const SessionReplayer&) = delete;
+
+    /**
+     * @brief Gets whether every recorded frame has been replayed.
+     * @returns true if the replay is finished, false otherwise.
+     */
+    bool IsFinished() const noexcept { return _next_frame > _recording.Frames.size(); }
+
+    /**
+     * @brief Gets the frame time statistics of the frames replayed so far.
+     * @returns The replay statistics.
+     */
+    ReplayStats GetStats() const;
+
+  private:
+    void ReplayFrame();
+
+  private:
+    ImGuiContext* _ctx;
+    std::uint32_t _hook_id = 0;
+    SessionRecording _recording;
+    ReplayPace _pace;
+    std::size_t _next_frame = 0;
+    Clock::time_point _frame_start;
+    std::vector<double> _frame_times;
+    std::vector<std::uint32_t> _replayed_event_ids;
+};
+
+FLOW_UI_NAMESPACE_END
@@ -38,6 +38,8 @@ struct Colour
     constexpr Colour(std::uint8_t r, std::uint8_t g, std::uint8_t b) : R(r), G(g), B(b) {}
     constexpr Colour(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a) : R(r), G(g), B(b), A(a) {}
 
+    constexpr bool operator==(const Colour&) const noexcept = default;
+
   public:
     std::uint8_t R = 255;
     std::uint8_t G = 255;
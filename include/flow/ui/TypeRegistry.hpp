@@ -0,0 +1,168 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+#include "Style.hpp"
+
+#include <flow/core/NodeData.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+FLOW_UI_NAMESPACE_START
+
+namespace widgets
+{
+class InputInterface;
+}
+
+/**
+ * @brief Dense ID of a data type name interned in the type registry.
+ */
+using TypeId = std::uint32_t;
+
+/**
+ * @brief Constructor for the input field of a registered input type.
+ */
+using InputFieldConstructor_t =
+    std::function<std::shared_ptr<widgets::InputInterface>(std::string name, const SharedNodeData&)>;
+
+/**
+ * @brief Function returning the size in bytes of a data value of a registered type.
+ */
+using DataSizeFunction_t = std::function<std::size_t(const SharedNodeData&)>;
+
+/**
+ * @brief Whether data of one type can be linked to a port of another type.
+ */
+enum class TypeCompatibility : std::uint8_t
+{
+    Unresolved,
+    Incompatible,
+    Exact,
+    Convertible,
+};
+
+/**
+ * @brief Display information of a data type, resolved once when the type is interned.
+ */
+struct TypeInfo
+{
+    /// The ID of the type.
+    TypeId ID;
+
+    /// The name of the type.
+    std::string Name;
+
+    /// The colour of ports and links of this type.
+    Colour PortColour;
+
+    /// The icon shape of ports of this type.
+    PortIconType Icon;
+
+    /// The input field constructor of the type, empty if no input field is registered for the type.
+    InputFieldConstructor_t InputConstructor;
+
+    /// The size function of the type, empty if the size of values of the type is unknown.
+    DataSizeFunction_t DataSize;
+};
+
+/**
+ * @brief Registry interning data type names into dense IDs.
+ *
+ * @note The registry is only accessed from the UI thread. References to interned type infos stay valid for the
+ *       lifetime of the registry.
+ */
+class TypeRegistry
+{
+  public:
+    /**
+     * @brief Interns a type name, resolving its display information if it has not been seen before.
+     * @param type The name of the type.
+     * @returns The ID of the type.
+     */
+    TypeId Intern(std::string_view type);
+
+    /**
+     * @brief Gets the display information of an interned type.
+     * @param id The ID of the type.
+     * @returns The type info.
+     */
+    const TypeInfo& Get(TypeId id) const { return _types[id]; }
+
+    /**
+     * @brief Gets the number of interned types.
+     * @returns The number of interned types.
+     */
+    std::size_t Size() const noexcept { return _types.size(); }
+
+    /**
+     * @brief Sets the input field constructor of a type, interning the type if needed.
+     * @param type The name of the type.
+     * @param constructor The input field constructor.
+     */
+    void SetInputConstructor(std::string_view type, InputFieldConstructor_t constructor);
+
+    /**
+     * @brief Sets the size function of a type, interning the type if needed.
+     * @note Size functions are called from the threads running the graph, so must be set before any graphs run.
+     * @param type The name of the type.
+     * @param data_size The size function.
+     */
+    void SetDataSize(std::string_view type, DataSizeFunction_t data_size);
+
+    /**
+     * @brief Re-resolves the colour and icon of every interned type from the current style.
+     */
+    void Refresh();
+
+    /**
+     * @brief Sets the function used to check if one type can be converted to another.
+     * @param is_convertible The conversion check, taking the type names to convert from and to.
+     */
+    void SetConversionCheck(std::function<bool(std::string_view, std::string_view)> is_convertible);
+
+    /**
+     * @brief Gets whether data of one type can be linked to a port of another type.
+     *
+     * @note Results are cached in a matrix indexed by type ID and only computed the first time a pair is checked.
+     *
+     * @param from The ID of the type of the output port.
+     * @param to The ID of the type of the input port.
+     *
+     * @returns The compatibility of the two types.
+     */
+    TypeCompatibility GetCompatibility(TypeId from, TypeId to) const;
+
+    /**
+     * @brief Clears all cached compatibilities, e.g. after conversions or modules have been registered.
+     */
+    void InvalidateCompatibility() noexcept;
+
+  private:
+    void Resolve(TypeInfo& info) const;
+
+    struct NameHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+  private:
+    std::deque<TypeInfo> _types;
+    std::unordered_map<std::string, TypeId, NameHash, std::equal_to<>> _ids;
+
+    std::function<bool(std::string_view, std::string_view)> _is_convertible;
+    mutable std::vector<TypeCompatibility> _compatibility;
+    mutable std::size_t _compatibility_stride = 0;
+};
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,295 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+
+#include <flow/core/IndexableName.hpp>
+#include <flow/core/NodeData.hpp>
+#include <flow/core/UUID.hpp>
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+FLOW_UI_NAMESPACE_START
+
+class ViewFactory;
+
+/**
+ * @brief Bounded output sink for typed value formatters.
+ *
+ * Writes past the end of the buffer are dropped and mark the buffer as truncated, so formatters can write summaries
+ * without checking the remaining space themselves.
+ */
+class FormatBuffer
+{
+  public:
+    /**
+     * @brief Constructs a format buffer over caller provided storage.
+     * @param data The storage to write to.
+     * @param capacity The size of the storage in bytes.
+     */
+    FormatBuffer(char* data, std::size_t capacity) noexcept : _data{data}, _capacity{capacity} {}
+
+    /**
+     * @brief Formats and appends text to the buffer.
+     * @param format The fmt format string.
+     * @param args The format arguments.
+     * @returns A reference to the buffer.
+     */
+    template<typename... Args>
+    FormatBuffer& Format(fmt::format_string<Args...> format, Args&&... args)
+    {
+        const std::size_t remaining = Remaining();
+        const auto result = fmt::format_to_n(_data + _size, remaining, format, std::forward<Args>(args)...);
+        _truncated |= result.size > remaining;
+        _size += std::min(result.size, remaining);
+        return *this;
+    }
+
+    /**
+     * @brief Appends text to the buffer.
+     * @param text The text to append.
+     * @returns A reference to the buffer.
+     */
+    FormatBuffer& Append(std::string_view text) noexcept
+    {
+        const std::size_t count = std::min(text.size(), Remaining());
+        std::copy_n(text.data(), count, _data + _size);
+        _truncated |= count < text.size();
+        _size += count;
+        return *this;
+    }
+
+    /**
+     * @brief Appends a summary of a range, listing at most the given number of elements followed by the range size.
+     * @param range The range to summarise.
+     * @param max_elements The maximum number of elements to list.
+     * @returns A reference to the buffer.
+     */
+    template<std::ranges::input_range R>
+    FormatBuffer& AppendRange(const R& range, std::size_t max_elements = 8)
+    {
+        std::size_t count = 0;
+        Append("[");
+        for (const auto& element : range)
+        {
+            if (count == max_elements || IsTruncated())
+            {
+                Append(", ...");
+                break;
+            }
+
+            if (count++ > 0) Append(", ");
+            Format("{}", element);
+        }
+        Append("]");
+
+        if constexpr (std::ranges::sized_range<R>)
+        {
+            Format(" ({} elements)", std::ranges::size(range));
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Gets the text written to the buffer.
+     * @returns A view of the written text.
+     */
+    std::string_view View() const noexcept { return {_data, _size}; }
+
+    /**
+     * @brief Gets the number of bytes that can still be written.
+     * @returns The remaining capacity.
+     */
+    std::size_t Remaining() const noexcept { return _capacity - _size; }
+
+    /**
+     * @brief Gets whether any output was dropped because the buffer was full.
+     * @returns true if output was dropped, false otherwise.
+     */
+    bool IsTruncated() const noexcept { return _truncated; }
+
+  private:
+    char* _data;
+    std::size_t _capacity;
+    std::size_t _size = 0;
+    bool _truncated   = false;
+};
+
+/**
+ * @brief The result of formatting a port value for display.
+ */
+struct FormattedValue
+{
+    /// The complete formatted text of the value.
+    std::string Text;
+
+    /// The number of bytes of the text that make up the preview.
+    std::size_t PreviewSize = 0;
+
+    /// The number of lines in the complete text.
+    std::size_t LineCount = 0;
+
+    /// Byte offsets of the start of every row of the complete text, used for paging through truncated values.
+    std::vector<std::size_t> RowOffsets;
+
+    /**
+     * @brief Gets the preview portion of the formatted text.
+     * @returns The text capped to the configured preview size.
+     */
+    std::string_view Preview() const noexcept { return std::string_view(Text).substr(0, PreviewSize); }
+
+    /**
+     * @brief Gets whether the preview only shows part of the formatted text.
+     * @returns true if the value was truncated, false otherwise.
+     */
+    bool IsTruncated() const noexcept { return PreviewSize < Text.size(); }
+};
+
+/**
+ * @brief Identifies the port a formatted value belongs to.
+ *
+ * Ports are identified by their node and key rather than their address, as the memory of a deleted port can be reused
+ * by a port of another node.
+ */
+struct ValuePortKey
+{
+    /// The ID of the node the port belongs to.
+    flow::UUID Node;
+
+    /// The key of the port on its node.
+    flow::IndexableName Port;
+
+    /// Whether the port is an output, since an input and an output of a node can share a key.
+    bool IsOutput = false;
+
+    bool operator==(const ValuePortKey&) const = default;
+};
+
+/**
+ * @brief Service that formats port values on a worker thread so large values never stall the render thread.
+ *
+ * Values with a formatter registered on the view factory are formatted immediately into a bounded buffer, all other
+ * values fall back to NodeData::ToString on the worker thread. Results are cached per port and only recomputed when
+ * the port receives a new data value. Requests for a port that
+ * is still waiting to be formatted are coalesced so only the most recent value is formatted. Every view showing a port
+ * value holds a reference to the port's cache entry through Acquire and Release, so views showing the same port share
+ * one formatted value.
+ */
+class ValueFormatter
+{
+  public:
+    ValueFormatter();
+    ~ValueFormatter();
+
+    /**
+     * @brief Adds a reference to the cache entry of a port.
+     * @param port The port the value belongs to.
+     */
+    void Acquire(const ValuePortKey& port);
+
+    /**
+     * @brief Removes a reference to the cache entry of a port, dropping the entry once it is no longer referenced.
+     * @param port The port the value belongs to.
+     */
+    void Release(const ValuePortKey& port);
+
+    /**
+     * @brief Drops the formatted values of every port of a node, e.g. after the node was deleted.
+     *
+     * The references to the entries are kept, so views of the node that are still alive release them as usual and the
+     * ports of a node recreated with the same ID start out without a value.
+     *
+     * @param node The ID of the node.
+     */
+    void Evict(const flow::UUID& node);
+
+    /**
+     * @brief Requests a port value be formatted, if it is not the value that was last requested for the port.
+     * @note The port must have been acquired first, otherwise the request is ignored.
+     * @param port The port the value belongs to.
+     * @param data The value to format.
+     * @param type The data type of the port, used to look up a registered formatter.
+     */
+    void Request(const ValuePortKey& port, const SharedNodeData& data, std::string_view type = {});
+
+    /**
+     * @brief Sets the view factory to look up typed formatters from.
+     * @param factory The view factory.
+     */
+    void SetViewFactory(const std::shared_ptr<const ViewFactory>& factory) { _factory = factory; }
+
+    /**
+     * @brief Gets the most recently formatted value of a port.
+     * @param port The port the value belongs to.
+     * @returns The formatted value, nullptr if nothing has been formatted for the port yet.
+     */
+    std::shared_ptr<const FormattedValue> Get(const ValuePortKey& port) const;
+
+    /**
+     * @brief Stops the worker thread. Requests made after stopping are ignored.
+     */
+    void Stop();
+
+  private:
+    struct Entry
+    {
+        std::weak_ptr<NodeData> Data;
+        std::shared_ptr<const FormattedValue> Result;
+        std::size_t References = 0;
+    };
+
+    std::shared_ptr<const FormattedValue> FormatTyped(const SharedNodeData& data, std::string_view type);
+    void Run(std::stop_token stop_token);
+
+  private:
+    mutable std::mutex _mutex;
+    std::condition_variable_any _condition;
+
+    struct PortKeyHash
+    {
+        std::size_t operator()(const ValuePortKey& key) const noexcept
+        {
+            const std::size_t hash = std::hash<flow::UUID>{}(key.Node) ^ std::hash<flow::IndexableName>{}(key.Port);
+            return key.IsOutput ? ~hash : hash;
+        }
+    };
+
+    std::unordered_map<ValuePortKey, Entry, PortKeyHash> _entries;
+    std::unordered_map<ValuePortKey, SharedNodeData, PortKeyHash> _pending;
+    std::deque<ValuePortKey> _queue;
+
+    std::weak_ptr<const ViewFactory> _factory;
+
+    std::jthread _worker;
+};
+
+/**
+ * @brief Formats a string for display, capping the preview to the configured number of bytes and lines.
+ * @param text The formatted text of a value.
+ * @returns The formatted value.
+ */
+FormattedValue MakeFormattedValue(std::string text);
+
+/**
+ * @brief Get the global value formatter.
+ * @returns The global value formatter.
+ */
+ValueFormatter& GetValueFormatter();
+
+FLOW_UI_NAMESPACE_END
@@ -4,16 +4,25 @@
 #pragma once
 
 #include "Core.hpp"
+#include "TypeRegistry.hpp"
+#include "ValueFormatter.hpp"
 #include "views/NodeView.hpp"
 #include "views/PortView.hpp"
 #include "widgets/InputField.hpp"
 
 #include <flow/core/Concepts.hpp>
+#include <flow/core/Event.hpp>
 #include <flow/core/NodeFactory.hpp>
 
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 FLOW_UI_NAMESPACE_START
 
@@ -28,7 +37,7 @@ class ViewFactory : public flow::NodeFactory
     using NodeViewConstructorCallback = std::function<NodeView*(flow::SharedNode)>;
 
   public:
-    ViewFactory()          = default;
+    ViewFactory();
     virtual ~ViewFactory() = default;
 
     /**
@@ -70,7 +79,7 @@ class ViewFactory : public flow::NodeFactory
     template<typename T>
     void RegisterInputType(const T& initial_value)
     {
-        _input_field_contructors[std::string{flow::TypeName_v<T>}] =
+        InputFieldConstructor_t constructor =
             [=](std::string name, const SharedNodeData& data) -> std::shared_ptr<widgets::InputInterface> {
             T value = initial_value;
             if (auto d = CastNodeData<T>(data))
@@ -84,13 +93,165 @@ class ViewFactory : public flow::NodeFactory
 
             return std::make_shared<widgets::Input<T>>(std::move(name), value);
         };
+
+        _types.SetInputConstructor(flow::TypeName_v<T>, std::move(constructor));
     }
 
     /**
      * @brief Get the list of registered input field constructors.
-     * @returns A reference to the map of registered input field constructors.
+     * @returns The registered input field constructors, by type name.
+     */
+    std::unordered_map<std::string, InputFieldConstructor_t> GetRegisteredInputTypes() const;
+
+    /**
+     * @brief Register a conversion from one type to another, clearing the cached port compatibilities.
+     *
+     * @tparam From The type to convert from.
+     * @tparam To The type to convert to.
+     * @param args The arguments of flow::NodeFactory::RegisterUnidirectionalConversion.
+     */
+    template<typename From, typename To, typename... Args>
+    void RegisterUnidirectionalConversion(Args&&... args)
+    {
+        flow::NodeFactory::RegisterUnidirectionalConversion<From, To>(std::forward<Args>(args)...);
+        _types.InvalidateCompatibility();
+    }
+
+    /**
+     * @brief Register conversions both ways between two types, clearing the cached port compatibilities.
+     *
+     * @tparam From The first type.
+     * @tparam To The second type.
+     * @param args The arguments of flow::NodeFactory::RegisterBidirectionalConversion.
      */
-    const auto& GetRegisteredInputTypes() { return _input_field_contructors; }
+    template<typename From, typename To, typename... Args>
+    void RegisterBidirectionalConversion(Args&&... args)
+    {
+        flow::NodeFactory::RegisterBidirectionalConversion<From, To>(std::forward<Args>(args)...);
+        _types.InvalidateCompatibility();
+    }
+
+    /**
+     * @brief Register a function to measure the size of values of a given type, used for link data rates.
+     *
+     * @tparam T The type to register.
+     * @param data_size The function that returns the size of a value in bytes.
+     */
+    template<typename T>
+    void RegisterDataSize(std::function<std::size_t(const T&)> data_size)
+    {
+        _types.SetDataSize(flow::TypeName_v<T>, [=](const SharedNodeData& data) -> std::size_t {
+            if (auto d = CastNodeData<T>(data))
+            {
+                return data_size(d->Get());
+            }
+            else if (auto ref_data = CastNodeData<T&>(data))
+            {
+                return data_size(ref_data->Get());
+            }
+
+            return 0;
+        });
+    }
+
+    /**
+     * @brief Get the registry of interned data types and their display information.
+     * @returns A reference to the type registry.
+     */
+    TypeRegistry& GetTypeRegistry() noexcept { return _types; }
+
+    /**
+     * @brief Get the registry of interned data types and their display information.
+     * @returns A const reference to the type registry.
+     */
+    const TypeRegistry& GetTypeRegistry() const noexcept { return _types; }
+
+    /**
+     * @brief Register a formatter used to display values of a given type.
+     *
+     * @note Formatters write into a bounded buffer and should only do work proportional to what they write, e.g. a
+     *       summary of the size and first few elements of a container rather than the entire container.
+     *
+     * @tparam T The type to register.
+     * @param formatter The function that writes the display text of a value into the buffer.
+     */
+    template<typename T>
+    void RegisterFormatter(std::function<void(const T&, FormatBuffer&)> formatter)
+    {
+        {
+            std::unique_lock _(_unformatted_mutex);
+            _unformatted_types.clear();
+        }
+
+        _formatters[std::string{flow::TypeName_v<T>}] = [=](const SharedNodeData& data, FormatBuffer& buffer) {
+            if (auto d = CastNodeData<T>(data))
+            {
+                formatter(d->Get(), buffer);
+                return true;
+            }
+            else if (auto ref_data = CastNodeData<T&>(data))
+            {
+                formatter(ref_data->Get(), buffer);
+                return true;
+            }
+
+            return false;
+        };
+    }
+
+    /**
+     * @brief Formats a value with its registered formatter.
+     *
+     * @param data The value to format.
+     * @param type The type name of the port the value belongs to. If no formatter is registered for this type, e.g.
+     *             for ports accepting any type, all registered formatters are tried. Types that none of them can
+     *             format are remembered until the next formatter is registered, except for ports accepting any type.
+     * @param buffer The buffer to write the display text to.
+     *
+     * @returns true if a registered formatter wrote the value, false otherwise.
+     */
+    bool FormatValue(const SharedNodeData& data, std::string_view type, FormatBuffer& buffer) const;
+
+    /**
+     * @brief Lists a node class in the catalog before the module that registers it is loaded.
+     *
+     * @param class_name The class name of the node.
+     * @param category The category to list the node in.
+     * @param friendly_name The name to display for the node.
+     */
+    void DeclareNodeClass(const std::string& class_name, std::string category, std::string friendly_name);
+
+    /**
+     * @brief Removes a node class declared with DeclareNodeClass from the catalog.
+     * @param class_name The class name of the node.
+     */
+    void RemoveDeclaredNodeClass(const std::string& class_name);
+
+    /**
+     * @brief Makes sure a node class is registered, asking for the module that declares it to be loaded if it is not.
+     * @param class_name The class name of the node.
+     * @returns true if the class is registered, false otherwise.
+     */
+    bool RequireNodeClass(const std::string& class_name);
+
+    /**
+     * @brief Gets every node class that can be created, registered or declared, by category.
+     * @returns The catalog of node classes.
+     */
+    const flow::CategoryMap& GetCatalog() const;
+
+    /**
+     * @brief Gets the friendly name of a node class in the catalog.
+     * @param class_name The class name of the node.
+     * @returns The friendly name.
+     */
+    std::string GetCatalogFriendlyName(const std::string& class_name) const;
+
+  public:
+    /**
+     * @brief Event that is run when a declared node class that is not registered yet is required.
+     */
+    Event<const std::string&> OnNodeClassRequired = [](const auto&) {};
 
   private:
     template<NodeViewType ViewType>
@@ -102,10 +263,34 @@ class ViewFactory : public flow::NodeFactory
   private:
     std::unordered_map<std::string, NodeViewConstructorCallback> _constructors;
 
-    using InputFieldConstructor_t =
-        std::function<std::shared_ptr<widgets::InputInterface>(std::string name, const SharedNodeData&)>;
+    TypeRegistry _types;
+
+    using Formatter_t = std::function<bool(const SharedNodeData&, FormatBuffer&)>;
+
+    struct NameHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    std::unordered_map<std::string, Formatter_t, NameHash, std::equal_to<>> _formatters;
+
+    /// Values are formatted from any thread, so the types without a formatter are shared behind a lock.
+    mutable std::shared_mutex _unformatted_mutex;
+    mutable std::unordered_set<std::string, NameHash, std::equal_to<>> _unformatted_types;
+
+    struct DeclaredNodeClass
+    {
+        std::string Category;
+        std::string FriendlyName;
+    };
+
+    std::unordered_map<std::string, DeclaredNodeClass> _declared_classes;
 
-    std::unordered_map<std::string, InputFieldConstructor_t> _input_field_contructors;
+    mutable flow::CategoryMap _catalog;
+    mutable std::unordered_set<std::string> _registered_classes;
+    mutable std::size_t _catalog_registered_count = 0;
+    mutable bool _catalog_dirty                   = true;
 };
 
 FLOW_UI_NAMESPACE_END
@@ -42,6 +42,11 @@ class Window
      */
     virtual void Teardown() {}
 
+    /**
+     * @brief Function that is run at the start of every frame, whether or not the window is visible.
+     */
+    virtual void Update() {}
+
     /**
      * @brief Draw function of the window.
      *
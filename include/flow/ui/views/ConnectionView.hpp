@@ -5,9 +5,14 @@
 
 #include "flow/ui/Core.hpp"
 #include "flow/ui/Style.hpp"
+#include "flow/ui/TypeRegistry.hpp"
 
+#include <flow/core/NodeData.hpp>
 #include <flow/core/UUID.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 
 FLOW_UI_NAMESPACE_START
@@ -23,10 +28,10 @@ class ConnectionView
      *
      * @param id The UUID hash of the Connection.
      * @param start_port_id The output Port ID.
-     * @param end_port_id
-     * @param colour
+     * @param end_port_id The input Port ID.
+     * @param type The type info of the output port, used for the colour and data size of the connection.
      */
-    ConnectionView(const flow::UUID& id, std::uint64_t start_port_id, std::uint64_t end_port_id, const Colour& colour);
+    ConnectionView(const flow::UUID& id, std::uint64_t start_port_id, std::uint64_t end_port_id, const TypeInfo& type);
 
     /**
      * @brief Render the connection to the graph.
@@ -34,22 +39,43 @@ class ConnectionView
     void Draw();
 
     /**
-     * @brief Gets the current flowing status of the connection.
-     * @returns true if the connection is flowing, false otherwise.
+     * @brief Counts data sent over the connection.
+     * @note Safe to call from any thread.
+     * @param data The data that was sent.
      */
-    bool IsFlowing() const noexcept { return _flowing; }
+    void RecordEvent(const SharedNodeData& data) noexcept;
 
     /**
-     * @brief Sets the connection's flowing status.
-     * @param flowing The new value for the flowing status.
+     * @brief Draws the event and data rates of the connection, e.g. inside a tooltip.
      */
-    void SetFlowing(bool flowing) noexcept { _flowing = flowing; }
+    void DrawStats() const;
+
+    /**
+     * @brief Gets the smoothed number of events sent over the connection per second.
+     * @returns The event rate.
+     */
+    float GetEventRate() const noexcept { return _event_rate; }
+
+    /**
+     * @brief Gets the number of events sent over the connection since the view was created.
+     * @returns The event count.
+     */
+    std::uint64_t GetEventCount() const noexcept { return _counters->Events.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the smoothed number of bytes sent over the connection per second.
+     * @returns The data rate, zero if the size of the data type is unknown.
+     */
+    float GetByteRate() const noexcept { return _byte_rate; }
 
     /**
      * @brief Gets the colour of the connection.
      * @returns The colour of the connection.
      */
-    const Colour& GetColour() const noexcept { return _colour; }
+    const Colour& GetColour() const noexcept { return _type->PortColour; }
+
+  private:
+    void UpdateRates();
 
   public:
     /// The UUID hash of the Connection.
@@ -62,8 +88,24 @@ class ConnectionView
     std::uint64_t EndPortID;
 
   private:
-    Colour _colour;
-    bool _flowing = false;
+    struct Counters
+    {
+        std::atomic<std::uint64_t> Events = 0;
+        std::atomic<std::uint64_t> Bytes  = 0;
+    };
+
+    const TypeInfo* _type;
+
+    // Counters are written from the threads running the graph, so they are kept on the heap to keep the view movable.
+    std::unique_ptr<Counters> _counters;
+
+    std::uint64_t _sampled_events = 0;
+    std::uint64_t _sampled_bytes  = 0;
+    std::uint64_t _flowed_events  = 0;
+    double _sample_time           = 0.0;
+    double _flow_time             = 0.0;
+    float _event_rate             = 0.f;
+    float _byte_rate              = 0.f;
 };
 
 FLOW_UI_NAMESPACE_END
@@ -4,11 +4,13 @@
 #pragma once
 
 #include "ConnectionView.hpp"
+#include "flow/ui/ComputeStats.hpp"
 #include "flow/ui/Core.hpp"
 
 #include <flow/core/Node.hpp>
 
 #include <deque>
+#include <optional>
 #include <set>
 #include <string_view>
 #include <type_traits>
@@ -85,6 +87,33 @@ class NodeView : public GraphItemView
      */
     void ShowConnectables(const std::shared_ptr<PortView>& port) override;
 
+    /**
+     * @brief Gets the compute timings of the node.
+     * @returns The compute stats of the node.
+     */
+    const NodeComputeStats& GetComputeStats() const noexcept { return *_compute_stats; }
+
+    /**
+     * @brief Gets the smoothed number of computes per second, updated while the node is drawn.
+     * @returns The call rate.
+     */
+    float GetCallRate() const noexcept { return _call_rate; }
+
+    /**
+     * @brief Draws the compute latency histogram and call rate of the node, e.g. inside a tooltip.
+     */
+    void DrawComputeStats();
+
+  protected:
+    /**
+     * @brief Gets the header colour tinted by the configured heatmap.
+     * @returns The colour to draw the header with.
+     */
+    Colour GetHeatmapColour();
+
+  private:
+    void UpdateCallRate();
+
   public:
     /// The ID of the node this view is for.
     UUID NodeID;
@@ -101,9 +130,17 @@ class NodeView : public GraphItemView
     /// The colour of the header.
     Colour HeaderColour;
 
+    /// The colour of the execution lane the node is assigned to, if any.
+    std::optional<Colour> LaneColour;
+
   protected:
     std::shared_ptr<utility::NodeBuilder> _builder;
     bool _received_error = false;
+
+    std::shared_ptr<NodeComputeStats> _compute_stats;
+    std::uint64_t _rate_calls = 0;
+    double _rate_time         = 0.0;
+    float _call_rate          = 0.f;
 };
 
 /**
@@ -5,6 +5,7 @@
 
 #include "flow/ui/Core.hpp"
 #include "flow/ui/Style.hpp"
+#include "flow/ui/TypeRegistry.hpp"
 
 #include <flow/core/Node.hpp>
 
@@ -88,6 +89,12 @@ class PortView
         return CastNodeData<T>(GetData());
     }
 
+    /**
+     * @brief Gets the port this view represents.
+     * @returns The port pointer.
+     */
+    const std::shared_ptr<Port>& GetPort() const noexcept { return _port; }
+
     /**
      * @brief Gets the unique hash key of the port.
      * @returns The IndexableName of the port.
@@ -106,11 +113,23 @@ class PortView
      */
     std::string_view Type() const noexcept { return _port->GetDataType(); }
 
+    /**
+     * @brief Gets the interned ID of the port data type.
+     * @returns The data type's ID in the type registry.
+     */
+    TypeId GetTypeID() const noexcept { return _type->ID; }
+
+    /**
+     * @brief Gets the display information of the port data type.
+     * @returns The data type's interned type info.
+     */
+    const TypeInfo& GetTypeInfo() const noexcept { return *_type; }
+
     /**
      * @brief Gets the colour of the data type.
      * @returns The data type's registered colour.
      */
-    Colour GetColour() const noexcept { return GetStyle().GetTypeColour(Type()); }
+    const Colour& GetColour() const noexcept { return _type->PortColour; }
 
     /**
      * @brief Sets the view builder pointer.
@@ -155,6 +174,8 @@ class PortView
 
   private:
     std::shared_ptr<Port> _port;
+    TypeRegistry* _types;
+    const TypeInfo* _type;
     std::shared_ptr<widgets::InputInterface> _input_field;
 
     bool _show_label = true;
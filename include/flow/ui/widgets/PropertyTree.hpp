@@ -3,15 +3,23 @@
 #include "flow/ui/Core.hpp"
 #include "flow/ui/Style.hpp"
 #include "flow/ui/Widget.hpp"
+#include "flow/ui/widgets/Table.hpp"
 
+#include <limits>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 FLOW_UI_SUBNAMESPACE_START(widgets)
 
 /**
  * @brief Property tree widget for showing user defined properties in a collapsable tree table.
+ *
+ * Each category is drawn as one table in row provider mode, with a header row for every property followed by rows of
+ * its widgets. Only the rows that are visible are drawn, so a category can hold any number of properties.
+ *
+ * @note Every row must have the height of a single line of framed widgets, as the rows are clipped by that height.
  */
 class PropertyTree : public Widget
 {
@@ -42,13 +50,74 @@ class PropertyTree : public Widget
     void AddProperty(const std::string& name, const std::vector<std::shared_ptr<Widget>>& widgets,
                      const std::string& category_name);
 
+    /**
+     * @brief Removes all properties from the tree.
+     */
+    void Clear() noexcept { _categories.clear(); }
+
     /**
      * @brief Renders the property tree widget to the windows.
      */
     virtual void operator()() noexcept override;
 
   private:
-    std::map<std::string, std::map<std::string, std::vector<std::shared_ptr<Widget>>>> _properties;
+    struct Property
+    {
+        /// The widgets representing the property, drawn in rows of the tree's columns.
+        std::vector<std::shared_ptr<Widget>> Widgets;
+
+        /// Whether the rows of the widgets are shown under the property's header.
+        bool Open = true;
+    };
+
+    static constexpr std::size_t HeaderRow = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief A row of a category's table, either the header of a property or a row of its widgets.
+     */
+    struct Row
+    {
+        /// The name of the property the row belongs to.
+        const std::string* Name = nullptr;
+
+        /// The property the row belongs to.
+        Property* Owner = nullptr;
+
+        /// The index of the first widget drawn in the row, or HeaderRow for the header of the property.
+        std::size_t FirstWidget = HeaderRow;
+    };
+
+    /**
+     * @brief The properties of a category and the table they are drawn in.
+     *
+     * The table's row provider refers to the category, so it is neither copied nor moved.
+     */
+    struct Category
+    {
+        Category(const std::string& name, std::size_t columns);
+
+        Category(const Category&)            = delete;
+        Category& operator=(const Category&) = delete;
+
+        /**
+         * @brief Rebuilds the rows from the properties and whether they are open.
+         */
+        void Layout();
+
+        /**
+         * @brief Draws one row of the table.
+         * @param row The index of the row.
+         */
+        void DrawRow(std::size_t row);
+
+        std::map<std::string, Property> Properties;
+        std::vector<Row> Rows;
+        Table View;
+        std::size_t Columns;
+        bool NeedsLayout = true;
+    };
+
+    std::map<std::string, Category> _categories;
     std::string _name;
     std::size_t _columns = 1;
 };
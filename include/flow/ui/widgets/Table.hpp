@@ -3,7 +3,9 @@
 #include "flow/ui/Core.hpp"
 #include "flow/ui/Widget.hpp"
 
+#include <cassert>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -16,6 +18,36 @@ FLOW_UI_SUBNAMESPACE_START(widgets)
 class Table : public Widget
 {
   public:
+    /// Draws the cells of a row, calling ImGui::TableNextColumn() before each one.
+    using RowProvider = std::function<void(std::size_t row)>;
+
+    /**
+     * @brief How the width of a column is set.
+     */
+    enum class ColumnSizing
+    {
+        /// Sized by the table's default policy.
+        Auto,
+
+        /// Sized to fit its contents.
+        Fixed,
+
+        /// Takes up the width left over by the other columns.
+        Stretch
+    };
+
+    /**
+     * @brief Which borders of the table are drawn.
+     */
+    enum class Borders
+    {
+        /// Borders around the table and between every cell.
+        All,
+
+        /// Only the borders around the table.
+        Outer
+    };
+
     /**
      * @brief Constructs a table with a name and number of columns.
      * @param name The name of the table.
@@ -33,17 +65,90 @@ class Table : public Widget
     /**
      * @brief Adds widget entry to the table in the next available column.
      * @param widget THe widget to add to the next column.
+     * @pre The table has no row provider.
      */
     void AddEntry(std::shared_ptr<Widget> widget);
 
     const std::shared_ptr<Widget>& GetEntry(std::size_t i) const { return _widgets.at(i); }
 
+    /**
+     * @brief Draws the rows of the table with a callback instead of its entries, only for the rows that are visible.
+     *
+     * No widget is kept per cell, so a table with any number of rows draws in the time of its visible rows. Every row
+     * must have the same height. Rows scroll inside the table if it has an outer height, with the window otherwise.
+     *
+     * @note A table is drawn either by its provider or from its entries, never both. Setting a provider clears the
+     *       entries, and entries must not be added to a table that has one.
+     *
+     * @param row_count The number of rows.
+     * @param provider The callback that draws a row.
+     */
+    void SetRowProvider(std::size_t row_count, RowProvider provider)
+    {
+        assert(provider);
+        _widgets.clear();
+        _row_count    = row_count;
+        _row_provider = std::move(provider);
+    }
+
+    /**
+     * @brief Sets the number of rows drawn by the row provider.
+     * @param row_count The number of rows.
+     */
+    void SetRowCount(std::size_t row_count) noexcept { _row_count = row_count; }
+
+    /**
+     * @brief Sets the outer size of the table.
+     * @param outer_width The outer width of the table.
+     * @param outer_height The outer height of the table.
+     */
+    void SetOuterSize(std::size_t outer_width, std::size_t outer_height = 0) noexcept
+    {
+        _outer_width  = outer_width;
+        _outer_height = outer_height;
+    }
+
+    /**
+     * @brief Sets how the width of a column is set.
+     * @param column The index of the column.
+     * @param sizing The sizing of the column.
+     * @pre column is less than the number of columns.
+     */
+    void SetColumnSizing(std::size_t column, ColumnSizing sizing) noexcept
+    {
+        assert(column < _column_sizing.size());
+        _column_sizing[column] = sizing;
+    }
+
+    /**
+     * @brief Sets which borders of the table are drawn.
+     * @param borders The borders to draw.
+     */
+    void SetBorders(Borders borders) noexcept { _borders = borders; }
+
+    /**
+     * @brief Sets the padding inside every cell.
+     * @param x The horizontal padding.
+     * @param y The vertical padding.
+     */
+    void SetCellPadding(float x, float y) noexcept
+    {
+        _cell_padding_x = x;
+        _cell_padding_y = y;
+    }
+
   private:
     std::string _name;
     std::size_t _columns      = 0;
     std::size_t _outer_width  = 0;
     std::size_t _outer_height = 0;
+    std::vector<ColumnSizing> _column_sizing;
+    Borders _borders      = Borders::All;
+    float _cell_padding_x = 15.f;
+    float _cell_padding_y = 5.f;
     std::vector<std::shared_ptr<Widget>> _widgets;
+    std::size_t _row_count = 0;
+    RowProvider _row_provider;
 };
 
 FLOW_UI_SUBNAMESPACE_END
@@ -61,6 +61,19 @@ class Text : public Widget
      */
     virtual void operator()() noexcept override;
 
+    /**
+     * @brief Sets the displayed text.
+     * @param new_text The new text to display.
+     * @returns A reference to the text widget.
+     */
+    Text& SetText(std::string new_text) noexcept;
+
+    /**
+     * @brief Gets the displayed text.
+     * @returns The text currently displayed.
+     */
+    const std::string& GetText() const noexcept { return _text; }
+
     /**
      * @brief Sets the text colour.
      * @param new_colour The new colour of the text.
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "flow/ui/Core.hpp"
+#include "flow/ui/ValueFormatter.hpp"
+#include "flow/ui/Widget.hpp"
+
+#include <memory>
+#include <string>
+
+FLOW_UI_SUBNAMESPACE_START(widgets)
+
+/**
+ * @brief Widget for showing the complete text of a formatted value.
+ *
+ * @note Only the rows that are visible in the scroll region are submitted, so values of any size can be shown.
+ */
+class TextViewer : public Widget
+{
+  public:
+    /**
+     * @brief Constructs a text viewer.
+     * @param name The name of the viewer.
+     * @param visible_rows The maximum number of rows shown before scrolling.
+     */
+    TextViewer(const std::string& name, std::size_t visible_rows = 20);
+
+    virtual ~TextViewer() = default;
+
+    /**
+     * @brief Renders the viewer to the window.
+     */
+    virtual void operator()() noexcept override;
+
+    /**
+     * @brief Sets the formatted value to show.
+     * @param value The formatted value.
+     */
+    void SetValue(std::shared_ptr<const FormattedValue> value) noexcept { _value = std::move(value); }
+
+  private:
+    std::string _name;
+    std::size_t _visible_rows;
+    std::shared_ptr<const FormattedValue> _value;
+};
+
+FLOW_UI_SUBNAMESPACE_END
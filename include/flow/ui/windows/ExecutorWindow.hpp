@@ -0,0 +1,50 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "flow/ui/Core.hpp"
+#include "flow/ui/Executor.hpp"
+#include "flow/ui/Window.hpp"
+
+#include <flow/core/Event.hpp>
+
+#include <memory>
+
+FLOW_UI_NAMESPACE_START
+
+class GraphWindow;
+
+/**
+ * @brief Window for editing the executor settings of the active graph.
+ */
+class ExecutorWindow : public Window
+{
+  public:
+    ExecutorWindow();
+    virtual ~ExecutorWindow() = default;
+
+    virtual void Draw() override;
+
+    /**
+     * @brief Sets the graph window whose executor settings are edited.
+     * @param graph_window The active graph window.
+     */
+    void SetCurrentGraph(const std::shared_ptr<GraphWindow>& graph_window);
+
+    /**
+     * @brief Event that is run when new executor settings are applied to a graph window.
+     */
+    Event<const std::shared_ptr<GraphWindow>&, const ExecutorSettings&> OnApply = [](const auto&, const auto&) {};
+
+  private:
+    void DrawAffinity();
+    void DrawLanes(const GraphWindow& graph_window);
+    bool LanesValid() const;
+
+  private:
+    std::weak_ptr<GraphWindow> _graph_window;
+    ExecutorSettings _settings;
+};
+
+FLOW_UI_NAMESPACE_END
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "flow/ui/Core.hpp"
+#include "flow/ui/Executor.hpp"
+#include "flow/ui/NodeSearch.hpp"
 #include "flow/ui/Widget.hpp"
 #include "flow/ui/Window.hpp"
 #include "flow/ui/views/NodeView.hpp"
@@ -14,8 +16,12 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <stack>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 FLOW_UI_NAMESPACE_START
@@ -32,17 +38,60 @@ class ContextMenu : public Widget
     virtual void operator()() noexcept override;
 
   private:
-    void DrawPopupCategory(const std::string& category, const flow::CategoryMap& registered_nodes);
+    void DrawPopupCategory(const std::string& category, std::span<const NodeSearch::Entry* const> entries);
 
   public:
     Event<const std::string&, const std::string&> OnSelection;
 
   private:
     std::shared_ptr<NodeFactory> _factory;
+    NodeSearch _search;
     std::string node_lookup;
     bool is_focused = false;
 };
 
+/**
+ * @brief Live statistics of the nodes assigned to an execution lane.
+ */
+struct LaneStats
+{
+    /// Number of nodes assigned to the lane.
+    std::size_t Nodes = 0;
+
+    /// Estimated number of inputs waiting for a compute, events delivered to the lane's nodes minus computes started.
+    std::uint64_t Queued = 0;
+
+    /// Computes per second across the lane's nodes.
+    float ComputeRate = 0.f;
+};
+
+/**
+ * @brief What is needed to recreate a node with the same ID, e.g. after the module providing its class is reloaded.
+ */
+struct NodeSnapshot
+{
+    /// The ID of the node.
+    flow::UUID ID;
+
+    /// The class name of the node.
+    std::string Class;
+
+    /// The display name of the node.
+    std::string Name;
+
+    /// The saved state of the node, including its inputs.
+    json State;
+
+    /// The position of the node in the editor.
+    json Position;
+
+    /// The execution lane the node is assigned to, empty if none.
+    std::string Lane;
+
+    /// The connections to and from the node.
+    std::vector<flow::SharedConnection> Connections;
+};
+
 /**
  * @brief Graph editor window for creating flows.
  */
@@ -188,28 +237,120 @@ class GraphWindow : public Window
      */
     std::shared_ptr<CommentView> FindComment(std::uint64_t id) const;
 
+    /**
+     * @brief Gets the IDs of all selected items in the graph, including comments.
+     * @returns The IDs of the selected items in selection order.
+     */
+    const std::vector<std::uint64_t>& GetSelectedIDs() const noexcept { return _selected_ids; }
+
+    /**
+     * @brief Gets the selected flow nodes mapped by their node view ID.
+     * @returns The selected flow nodes.
+     */
+    const std::unordered_map<std::uint64_t, flow::SharedNode>& GetSelectedNodes() const noexcept
+    {
+        return _selected_nodes;
+    }
+
+    /**
+     * @brief Gets the selection version, which is incremented every time the selection changes.
+     * @returns The current selection version.
+     */
+    std::uint64_t GetSelectionVersion() const noexcept { return _selection_version; }
+
+    /**
+     * @brief Removes every node of a class along with its links, e.g. when the module providing it is unloaded.
+     * @param class_name The class name of the nodes to remove.
+     * @returns The number of nodes that were removed.
+     */
+    std::size_t RemoveNodesOfClass(const std::string& class_name);
+
+    /**
+     * @brief Removes every node of the given classes, keeping what is needed to recreate them with RestoreNodes.
+     * @param class_names The class names of the nodes, e.g. those of a module that is about to be reloaded.
+     * @returns The snapshots of the removed nodes.
+     */
+    std::vector<NodeSnapshot> DetachNodesOfClasses(const std::unordered_set<std::string>& class_names);
+
+    /**
+     * @brief Recreates nodes removed by DetachNodesOfClasses, with their IDs, inputs, lanes and connections.
+     *
+     * Only the views of the given nodes and their links are rebuilt. Nodes whose class is no longer registered and
+     * connections to ports that no longer exist are dropped.
+     *
+     * @param snapshots The snapshots of the nodes.
+     */
+    void RestoreNodes(const std::vector<NodeSnapshot>& snapshots);
+
     /**
      * @brief Marks the window as dirty/modified.
      * @param new_value true for when the window has been modified, false otherwise.
      */
     void MarkDirty(bool new_value) { _dirty = new_value; }
 
+    /**
+     * @brief Gets whether the window has unsaved modifications.
+     * @returns true if the window has been modified, false otherwise.
+     */
+    bool IsDirty() const noexcept { return _dirty; }
+
+    /**
+     * @brief Gets the settings of the executor the graph runs on, which are saved with the flow.
+     * @returns The executor settings.
+     */
+    const ExecutorSettings& GetExecutorSettings() const noexcept { return _executor_settings; }
+
+    /**
+     * @brief Sets the executor settings saved with the flow.
+     * @param settings The settings of the executor the graph was created with.
+     */
+    void SetExecutorSettings(const ExecutorSettings& settings) { _executor_settings = settings; }
+
+    /**
+     * @brief Assigns a node to one of the executor settings' lanes, recreating it on the lane's environment.
+     * @param node_id The ID of the flow node.
+     * @param lane The name of the lane, empty to run the node on the graph's environment.
+     */
+    void SetNodeLane(const flow::UUID& node_id, const std::string& lane);
+
+    /**
+     * @brief Gets the lane a node is assigned to.
+     * @param node_id The ID of the flow node.
+     * @returns The name of the lane, empty if the node runs on the graph's environment.
+     */
+    std::string GetNodeLane(const flow::UUID& node_id) const;
+
+    /**
+     * @brief Gets the live statistics of a lane.
+     * @param lane The name of the lane.
+     * @returns The lane statistics.
+     */
+    LaneStats GetLaneStats(const std::string& lane) const;
+
   private:
     void EndDraw();
 
     const std::shared_ptr<flow::Env>& GetEnv() const { return _graph->GetEnv(); }
 
     void DeleteNode(std::uint64_t id);
+    bool EraseNode(std::uint64_t id);
     bool DeleteLink(std::uint64_t id);
-    void ShowLinkFlowing(const flow::UUID& node_id, const IndexableName& key);
+    void ShowLinkFlowing(const flow::UUID& node_id, const IndexableName& key, const SharedNodeData& data);
 
     void CreateItems();
     void CleanupDeadItems();
+    void UpdateSelection();
 
     void OnLoadNode(const flow::SharedNode& node, const json& position_json);
     void OnLoadConnection(const flow::SharedConnection& connection);
+    void AddNodeView(const std::shared_ptr<NodeView>& node_view, const flow::SharedNode& node);
+    void AddLink(const flow::SharedConnection& connection, const PortView& start_pin, const PortView& end_pin);
 
     flow::SharedNode CreateNode(const std::string& class_name, const std::string& display_name);
+    flow::SharedNode MoveNode(const flow::SharedNode& node, std::shared_ptr<flow::Env> env);
+    NodeSnapshot SnapshotNode(const flow::SharedNode& node) const;
+    flow::SharedNode RecreateNode(const NodeSnapshot& snapshot, std::shared_ptr<flow::Env> env);
+    const std::shared_ptr<flow::Env>& GetLaneEnv(const ExecutionLane& lane);
 
   private:
     mutable std::mutex _mutex;
@@ -218,14 +359,26 @@ class GraphWindow : public Window
 
     std::unordered_map<std::uint64_t, std::shared_ptr<GraphItemView>> _item_views;
     std::unordered_map<std::uint64_t, ConnectionView> _links;
+    std::mutex _links_mutex;
+    std::unordered_map<std::string, std::unordered_set<std::uint64_t>> _class_nodes;
+    std::unordered_map<std::uint64_t, std::unordered_set<std::uint64_t>> _node_links;
+
+    std::vector<std::uint64_t> _selected_ids;
+    std::unordered_map<std::uint64_t, flow::SharedNode> _selected_nodes;
+    std::uint64_t _selection_version = 0;
 
     std::stack<Action> _undo_history;
     std::stack<Action> _redo_history;
 
     std::shared_ptr<PortView> _new_node_link_pin = nullptr;
     std::shared_ptr<PortView> _new_link_pin      = nullptr;
+    std::shared_ptr<PortView> _shown_link_pin    = nullptr;
+    bool _connectables_dirty                     = true;
 
     ContextMenu _node_creation_context_menu;
+    ExecutorSettings _executor_settings;
+    std::unordered_map<std::string, std::shared_ptr<flow::Env>> _lane_envs;
+    std::unordered_map<flow::UUID, std::string> _node_lanes;
 
     struct
     {
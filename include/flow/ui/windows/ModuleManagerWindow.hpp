@@ -6,38 +6,98 @@
 #include "flow/ui/windows/NewModuleWindow.hpp"
 
 #include <flow/core/Env.hpp>
+#include <flow/core/Event.hpp>
 
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 FLOW_UI_NAMESPACE_START
 
+namespace utility
+{
+class FileWatcher;
+}
+
+namespace widgets
+{
+class Table;
+}
+
+class ModuleBuilder;
+class ModuleView;
+struct ModuleManifest;
+
 /**
  * @brief Windows for displaying available modules and which of them are loaded/unloaded.
  */
 class ModuleManagerWindow : public Window
 {
   public:
+    using ReloadEvent = Event<const std::unordered_set<std::string>&, const std::function<void()>&>;
+
     /**
      * @brief Constructs a module manager window with a shared environment and a specified modules path.
+     *
+     * The modules path is scanned for module manifests in the background and the discovered modules are loaded in the
+     * background.
+     *
      * @param env The shared environment.
      * @param modules_path The path to the modules directory.
      */
     ModuleManagerWindow(std::shared_ptr<Env> env, const std::filesystem::path& modules_path);
 
-    virtual ~ModuleManagerWindow() = default;
+    virtual ~ModuleManagerWindow();
 
     /**
      * @brief Renders the window to the screen.
      */
     virtual void Draw() override;
 
+    /**
+     * @brief Commits modules that finished loading or unloading in the background, so they are registered with the
+     * node factory between frames, even while the window is hidden.
+     */
+    virtual void Update() override;
+
+    /**
+     * @brief Event that is run to reload a module whose files changed while hot reload is on.
+     *
+     * It is given the node classes the module registered and the function that reloads it, which it has to call.
+     * Reloading destroys every node of those classes, so graphs can take them out before and recreate them after.
+     */
+    ReloadEvent OnModuleReload = [](const auto&, const auto& reload) { reload(); };
+
+  private:
+    void FinishScan();
+    void LoadModuleOf(const std::string& class_name);
+    void SetHotReload(bool enabled);
+    void AddModule(const std::string& key, std::shared_ptr<ModuleView> view);
+    void WatchModule(const std::string& key);
+    void StartBuild(const std::filesystem::path& project_dir);
+    void InstallBuiltModule();
+    void DrawBuildLog();
+
   private:
     std::shared_ptr<Env> _env;
     std::filesystem::path _modules_path;
-    std::map<std::string, std::shared_ptr<Widget>> _widgets;
+    std::map<std::string, std::shared_ptr<ModuleView>> _widgets;
+    std::vector<ModuleView*> _module_rows;
     std::unique_ptr<NewModuleWindow> _new_module_window;
+    std::unique_ptr<ModuleBuilder> _builder;
+    std::unique_ptr<widgets::Table> _module_table;
+    std::future<std::vector<ModuleManifest>> _scan;
+    std::unordered_map<std::string, std::string> _class_modules;
+
+    bool _hot_reload = false;
+    std::unique_ptr<utility::FileWatcher> _watcher;
+    std::unordered_map<std::string, std::string> _watched_files;
 };
 
 FLOW_UI_NAMESPACE_END
@@ -5,6 +5,8 @@
 #include "widgets/InputField.hpp"
 #include "widgets/Table.hpp"
 
+#include <filesystem>
+
 FLOW_UI_NAMESPACE_START
 
 class NewModuleWindow : public Window
@@ -13,8 +15,18 @@ class NewModuleWindow : public Window
     NewModuleWindow();
     virtual ~NewModuleWindow() = default;
 
+    /**
+     * @brief Draws the form and generates the project files once it is submitted.
+     * @returns true if a project was created, which still has to be built, false otherwise.
+     */
     bool DrawAndCreate();
 
+    /**
+     * @brief Gets the directory of the project that was created last.
+     * @returns The project directory.
+     */
+    const std::filesystem::path& GetProjectDir() const noexcept { return project_dir; }
+
   public:
     static inline const std::string Name = "Create New Module";
 
@@ -27,6 +39,8 @@ class NewModuleWindow : public Window
     std::shared_ptr<widgets::Input<std::string>> author_input;
     std::shared_ptr<widgets::Input<std::string>> description_input;
     std::shared_ptr<widgets::Table> dependencies;
+    std::shared_ptr<widgets::Input<bool>> benchmark_input;
+    std::filesystem::path project_dir;
 };
 
 FLOW_UI_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core.hpp"
+#include "NodeSearch.hpp"
 #include "Window.hpp"
 
 #include <flow/core/Env.hpp>
@@ -8,6 +9,8 @@
 #include <flow/core/Graph.hpp>
 #include <flow/core/NodeFactory.hpp>
 
+#include <span>
+
 FLOW_UI_NAMESPACE_START
 
 class NodeExplorerWindow : public Window
@@ -21,12 +24,13 @@ class NodeExplorerWindow : public Window
     void SetActiveGraph(std::shared_ptr<Graph> graph) { _active_graph = std::move(graph); }
 
   private:
-    void DrawPopupCategory(const std::string& category, const flow::CategoryMap& registered_nodes);
+    void DrawPopupCategory(const std::string& category, std::span<const NodeSearch::Entry* const> entries);
 
   private:
     std::shared_ptr<Env> _env;
     std::shared_ptr<Graph> _active_graph;
     std::string node_lookup;
+    NodeSearch _search;
     struct
     {
         std::string class_name;
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Core.hpp"
+#include "Window.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+FLOW_UI_NAMESPACE_START
+
+/**
+ * @brief Window showing the recent frame times and where the time of each frame was spent.
+ */
+class ProfilerWindow : public Window
+{
+  public:
+    ProfilerWindow();
+    virtual ~ProfilerWindow() = default;
+
+    virtual void Draw() override;
+
+  private:
+    struct ScopeStats
+    {
+        const char* Name   = nullptr;
+        std::size_t Calls  = 0;
+        std::int64_t Total = 0;
+        std::int64_t Max   = 0;
+    };
+
+    void UpdateStats();
+
+  private:
+    std::vector<ScopeStats> _stats;
+    std::int64_t _last_update = 0;
+    std::size_t _frames       = 0;
+    int _export_seconds       = 5;
+};
+
+FLOW_UI_NAMESPACE_END
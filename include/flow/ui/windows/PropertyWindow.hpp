@@ -7,28 +7,51 @@
 #include "flow/ui/Window.hpp"
 
 #include <flow/core/Env.hpp>
-#include <flow/core/Graph.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 FLOW_UI_NAMESPACE_START
 
+class GraphWindow;
+
+/**
+ * @brief Window that shows the ports and their data of the currently selected nodes.
+ *
+ * @note The displayed properties are retained between frames and only rebuilt when the selection of the active graph
+ *       window changes. Port values are only re-stringified after the node reports new data.
+ */
 class PropertyWindow : public Window
 {
   public:
     PropertyWindow(std::shared_ptr<flow::Env> env);
-    virtual ~PropertyWindow() = default;
+    virtual ~PropertyWindow();
 
     virtual void Draw() override;
 
-    void SetCurrentGraph(std::shared_ptr<flow::Graph> graph) { _graph = graph; }
+    /**
+     * @brief Sets the graph window whose selected nodes are displayed.
+     * @param graph_window The active graph window.
+     */
+    void SetCurrentGraph(const std::shared_ptr<GraphWindow>& graph_window);
 
     static inline const std::string Name = "Properties";
 
+  private:
+    struct NodeProperties;
+
+    void Rebuild(const GraphWindow& graph_window);
+    void ClearProperties();
+
   private:
     std::weak_ptr<flow::Env> _env;
-    std::weak_ptr<flow::Graph> _graph;
+    std::weak_ptr<GraphWindow> _graph_window;
+
+    std::vector<std::shared_ptr<NodeProperties>> _node_properties;
+    std::uint64_t _selection_version = 0;
+    bool _needs_rebuild              = true;
 };
 
 FLOW_UI_NAMESPACE_END
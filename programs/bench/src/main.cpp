@@ -0,0 +1,326 @@
+#include "FlowGenerator.hpp"
+#include "SyntheticNodes.hpp"
+
+#include <cxxopts.hpp>
+#include <flow/core/Env.hpp>
+#include <flow/core/Graph.hpp>
+#include <flow/core/UUID.hpp>
+#include <flow/ui/FrameArena.hpp>
+#include <flow/ui/SessionRecorder.hpp>
+#include <flow/ui/ViewFactory.hpp>
+#include <flow/ui/windows/GraphWindow.hpp>
+#include <imgui.h>
+#include <imgui_node_editor.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ed = ax::NodeEditor;
+using json   = nlohmann::json;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double ToMilliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/**
+ * @brief Timings of an operation and of the frame that applied it, since the graph window applies deletions while
+ * drawing.
+ */
+struct OpTiming
+{
+    double Op    = 0.0;
+    double Frame = 0.0;
+};
+
+void to_json(json& j, const OpTiming& timing) { j = {{"op_ms", timing.Op}, {"frame_ms", timing.Frame}}; }
+
+json Summarise(std::vector<double> samples)
+{
+    if (samples.empty()) return json::object();
+
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&](double p) {
+        return samples[static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1))];
+    };
+
+    double total = 0.0;
+    for (double sample : samples)
+    {
+        total += sample;
+    }
+
+    return {
+        {"mean_ms", total / static_cast<double>(samples.size())},
+        {"p50_ms", percentile(0.5)},
+        {"p95_ms", percentile(0.95)},
+        {"max_ms", samples.back()},
+    };
+}
+
+/**
+ * @brief Drives a graph window through headless ImGui frames.
+ */
+class Harness
+{
+  public:
+    explicit Harness(flow::ui::GraphWindow& window) : _window{window} {}
+
+    OpTiming Frame(const std::function<void()>& op = {})
+    {
+        auto& io     = ImGui::GetIO();
+        io.DeltaTime = 1.f / 60.f;
+
+        const auto start = Clock::now();
+
+        flow::ui::GetFrameArena().Reset();
+        ImGui::NewFrame();
+
+        const auto op_start = Clock::now();
+        if (op)
+        {
+            _window.SetCurrentGraph();
+            op();
+        }
+        const auto op_end = Clock::now();
+
+        ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(io.DisplaySize, ImGuiCond_Always);
+        _window.Draw();
+
+        ImGui::Render();
+
+        return {ToMilliseconds(op_end - op_start), ToMilliseconds(Clock::now() - start)};
+    }
+
+  private:
+    flow::ui::GraphWindow& _window;
+};
+
+json RunBenchmark(const std::shared_ptr<flow::Env>& env, const flow::synthetic::GeneratorOptions& generator_options,
+                  std::size_t frames, std::size_t selection_count)
+{
+    SPDLOG_INFO("Benchmarking {} nodes", generator_options.Nodes);
+
+    const json flow_json = flow::synthetic::GenerateFlow(generator_options, env);
+
+    std::vector<flow::UUID> node_ids;
+    for (const auto& node_json : flow_json["nodes"])
+    {
+        node_ids.emplace_back(node_json["id"].get<std::string>());
+    }
+
+    flow::ui::GraphWindow window(std::make_shared<flow::Graph>("Benchmark", env));
+    Harness harness(window);
+
+    json result;
+    result["nodes"] = flow_json["nodes"].size();
+    result["links"] = flow_json["connections"].size();
+
+    result["LoadFlow"] = harness.Frame([&] { window.LoadFlow(flow_json); });
+
+    // The first frames lay out every node, so they are reported separately from the steady state.
+    std::vector<double> warmup;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        warmup.push_back(harness.Frame().Frame);
+    }
+    result["FirstFrames"] = Summarise(std::move(warmup));
+
+    std::vector<double> frame_times;
+    frame_times.reserve(frames);
+    for (std::size_t i = 0; i < frames; ++i)
+    {
+        frame_times.push_back(harness.Frame().Frame);
+    }
+    result["Draw"] = Summarise(std::move(frame_times));
+
+    json saved;
+    result["SaveFlow"] = harness.Frame([&] { saved = window.SaveFlow(); });
+
+    const std::size_t selected = std::min(selection_count, node_ids.size());
+    harness.Frame([&] {
+        ed::ClearSelection();
+        for (std::size_t i = 0; i < selected; ++i)
+        {
+            ed::SelectNode(std::hash<flow::UUID>{}(node_ids[i]), true);
+        }
+    });
+    harness.Frame();
+    result["selected"] = window.GetSelectedNodes().size();
+
+    json copied;
+    result["CopySelection"] = harness.Frame([&] { copied = window.CopySelection(); });
+    if (!copied["nodes"].empty())
+    {
+        result["CreateNodesAction"] = harness.Frame([&] { window.CreateNodesAction(copied); });
+        result["UndoChange"]        = harness.Frame([&] { window.UndoChange(); });
+        result["RedoChange"]        = harness.Frame([&] { window.RedoChange(); });
+    }
+
+    result["Delete"] = harness.Frame([&] {
+        for (std::size_t i = 0; i < selected; ++i)
+        {
+            ed::DeleteNode(std::hash<flow::UUID>{}(node_ids[i]));
+        }
+    });
+
+    env->Wait();
+
+    return result;
+}
+
+/**
+ * @brief Replays a recorded session into the graph window alone, so the window covers the whole display rather than
+ * the area it had in the editor.
+ */
+json RunReplay(const std::shared_ptr<flow::Env>& env, const std::filesystem::path& file, flow::ui::ReplayPace pace)
+{
+    auto recording = flow::ui::SessionRecording::Load(file);
+    SPDLOG_INFO("Replaying {} frames of '{}'", recording.Frames.size(), recording.FlowName);
+
+    ImGui::GetIO().DisplaySize = ImVec2(recording.DisplayWidth, recording.DisplayHeight);
+
+    flow::ui::GraphWindow window(std::make_shared<flow::Graph>(recording.FlowName, env));
+    Harness harness(window);
+
+    json result;
+    result["flow"]     = recording.FlowName;
+    result["LoadFlow"] = harness.Frame([&] { window.LoadFlow(recording.Flow); });
+
+    flow::ui::SessionReplayer replayer(ImGui::GetCurrentContext(), std::move(recording), pace);
+    while (!replayer.IsFinished())
+    {
+        harness.Frame();
+    }
+
+    result["Replay"] = replayer.GetStats();
+
+    env->Wait();
+
+    return result;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // clang-format off
+    cxxopts::Options options("flow-ui-bench", "Headless benchmark of the flow-ui graph editor");
+    options.add_options()
+        ("n,nodes", "Node counts of the generated graphs", cxxopts::value<std::vector<std::size_t>>()->default_value("1000,10000,100000"))
+        ("f,frames", "Frames to draw per graph", cxxopts::value<std::size_t>()->default_value("120"))
+        ("s,selection", "Nodes to copy, paste and delete", cxxopts::value<std::size_t>()->default_value("100"))
+        ("seed", "Seed of the generated graphs", cxxopts::value<std::uint64_t>()->default_value("0"))
+        ("t,topology", "Graph shape [chain, dag, layered]", cxxopts::value<std::string>()->default_value("dag"))
+        ("r,replay", "Replay a recorded session instead of the generated graphs", cxxopts::value<std::string>())
+        ("replay-fast", "Replay frames back to back instead of at the recorded pace")
+        ("o,output", "File to write the JSON results to, stdout if not set", cxxopts::value<std::string>())
+        ("l,log_level", "Logging level [trace = 0, debug = 1, info = 2, warn = 3, err = 4, critical = 5, off = 6]", cxxopts::value<int>())
+        ("h,help", "Print usage");
+    // clang-format on
+
+    cxxopts::ParseResult result;
+
+    try
+    {
+        result = options.parse(argc, argv);
+    }
+    catch (const cxxopts::exceptions::exception& e)
+    {
+        std::cerr << "Caught exception while parsing arguments: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (result.count("help"))
+    {
+        std::cerr << options.help() << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+    if (result.count("log_level"))
+    {
+        spdlog::set_level(static_cast<spdlog::level::level_enum>(result["log_level"].as<int>()));
+    }
+
+    const auto node_counts = result["nodes"].as<std::vector<std::size_t>>();
+    const auto frames      = result["frames"].as<std::size_t>();
+    const auto selection   = result["selection"].as<std::size_t>();
+
+    // No renderer backend is created, frames are built and then dropped after ImGui::Render.
+    ImGui::CreateContext();
+    auto& io       = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.Fonts->AddFontDefault();
+    io.Fonts->Build();
+    io.AddMousePosEvent(io.DisplaySize.x / 2, io.DisplaySize.y / 2);
+
+    auto factory = std::make_shared<flow::ui::ViewFactory>();
+    flow::synthetic::RegisterNodes(factory);
+    auto env = flow::Env::Create(factory);
+
+    json report;
+
+    try
+    {
+        if (result.count("replay"))
+        {
+            using flow::ui::ReplayPace;
+            const auto pace = result.count("replay-fast") ? ReplayPace::Unthrottled : ReplayPace::Recorded;
+
+            report = RunReplay(env, result["replay"].as<std::string>(), pace);
+        }
+        else
+        {
+            report["frames"]    = frames;
+            report["selection"] = selection;
+            report["seed"]      = result["seed"].as<std::uint64_t>();
+            report["topology"]  = result["topology"].as<std::string>();
+            report["results"]   = json::array();
+
+            flow::synthetic::GeneratorOptions generator_options;
+            generator_options.Seed  = result["seed"].as<std::uint64_t>();
+            generator_options.Shape = flow::synthetic::ParseTopology(result["topology"].as<std::string>());
+
+            for (const auto node_count : node_counts)
+            {
+                generator_options.Nodes = node_count;
+                report["results"].push_back(RunBenchmark(env, generator_options, frames, selection));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        SPDLOG_CRITICAL("Benchmark failed: {}", e.what());
+        ImGui::DestroyContext();
+        return EXIT_FAILURE;
+    }
+
+    ImGui::DestroyContext();
+
+    if (result.count("output"))
+    {
+        std::ofstream out(result["output"].as<std::string>());
+        out << report.dump(4) << std::endl;
+    }
+    else
+    {
+        std::cout << report.dump(4) << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
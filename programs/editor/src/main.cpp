@@ -1,22 +1,235 @@
 #include <cxxopts.hpp>
+#include <flow/core/Env.hpp>
+#include <flow/core/Graph.hpp>
+#include <flow/core/Module.hpp>
+#include <flow/ui/AllocationCounter.hpp>
 #include <flow/ui/Config.hpp>
 #include <flow/ui/Editor.hpp>
+#include <flow/ui/Executor.hpp>
+#include <flow/ui/FileExplorer.hpp>
+#include <flow/ui/ViewFactory.hpp>
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <csignal>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef NDEBUG
+// Count heap allocations so debug builds fail on frames that allocate while the editor is idle.
+FLOW_UI_COUNT_ALLOCATIONS()
+#endif
+
+namespace
+{
+/// Exit code used when a headless run is stopped by its timeout, matching timeout(1).
+constexpr int timeout_exit_code = 124;
+
+std::atomic_bool stop_requested = false;
+
+void RequestStop(int) { stop_requested = true; }
+
+/**
+ * @brief Moves the nodes that the flow assigns to execution lanes onto executors of their own, as the editor does.
+ * @returns The environments of the lanes that nodes were moved to.
+ */
+std::vector<std::shared_ptr<flow::Env>> AssignLanes(flow::Graph& graph, const flow::ui::json& flow_json,
+                                                    const flow::ui::ExecutorSettings& settings,
+                                                    const std::shared_ptr<flow::NodeFactory>& factory)
+{
+    if (!flow_json.contains("nodes")) return {};
+
+    std::unordered_map<std::string, std::shared_ptr<flow::Env>> lane_envs;
+    const auto& lanes = settings.Lanes;
+    for (const auto& node_json : flow_json["nodes"])
+    {
+        const auto lane_json = node_json.find("lane");
+        if (lane_json == node_json.end()) continue;
+
+        const auto& lane_name = lane_json->get_ref<const std::string&>();
+
+        const flow::UUID id{node_json["id"]};
+        auto node = graph.GetNode(id);
+        if (!node) continue;
+
+        const auto lane = std::find_if(lanes.begin(), lanes.end(), [&](const auto& l) { return l.Name == lane_name; });
+        if (lane == lanes.end())
+        {
+            SPDLOG_WARN("Node '{}' is assigned to unknown execution lane '{}'", node->GetName(), lane_name);
+            continue;
+        }
+
+        auto& env = lane_envs[lane->Name];
+        if (!env) env = flow::ui::CreateLaneExecutor(factory, settings, *lane);
+
+        try
+        {
+            flow::ui::MoveNodeToEnv(graph, node, env);
+        }
+        catch (const std::exception& e)
+        {
+            SPDLOG_ERROR("Failed to move node '{}' to execution lane '{}': {}", node->GetName(), lane->Name, e.what());
+        }
+    }
+
+    std::vector<std::shared_ptr<flow::Env>> envs;
+    for (auto& [_, env] : lane_envs)
+    {
+        envs.push_back(std::move(env));
+    }
+
+    return envs;
+}
+
+/**
+ * @brief Runs a flow without creating an ImGui context or any windows.
+ *
+ * Every module in the modules directory is loaded, then the graph runs on the environment's executor until its tasks
+ * are done, SIGINT or SIGTERM is received, or the timeout expires.
+ */
+int RunHeadless(const std::filesystem::path& flow_file, const std::filesystem::path& modules_path,
+                std::size_t threads, std::chrono::seconds timeout)
+{
+    flow::ui::json flow_json;
+    try
+    {
+        std::ifstream i;
+        i.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+        i.open(flow_file);
+        i >> flow_json;
+        i.close();
+    }
+    catch (const std::exception& e)
+    {
+        SPDLOG_CRITICAL("Failed to load file '{0}': {1}", flow_file.string(), e.what());
+        return EXIT_FAILURE;
+    }
+
+    // The executor saved with the flow is used unless the thread count is overridden.
+    auto settings = flow_json.value("executor", flow::ui::ExecutorSettings{});
+    if (threads > 0) settings.Threads = threads;
+
+    auto factory = std::make_shared<flow::ui::ViewFactory>();
+    auto env     = settings.Threads > 0 ? flow::ui::CreateExecutor(factory, settings) : flow::Env::Create(factory);
+
+    std::vector<std::shared_ptr<flow::Module>> modules;
+    if (std::filesystem::is_directory(modules_path))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(modules_path))
+        {
+            if (entry.path().extension() != ".flowmod") continue;
+
+            try
+            {
+                auto module = std::make_shared<flow::Module>(entry.path(), factory);
+                module->Load(entry.path());
+                SPDLOG_INFO("Loaded module '{0}' {1}", module->GetName(), module->GetVersion());
+                modules.push_back(std::move(module));
+            }
+            catch (const std::exception& e)
+            {
+                SPDLOG_ERROR("Failed to load module '{0}': {1}", entry.path().string(), e.what());
+            }
+        }
+    }
+
+    auto graph = std::make_shared<flow::Graph>(flow_file.stem().string(), env);
+    try
+    {
+        flow_json.get_to(*graph);
+    }
+    catch (const std::exception& e)
+    {
+        SPDLOG_CRITICAL("Failed to create flow '{0}': {1}", flow_file.string(), e.what());
+        return EXIT_FAILURE;
+    }
+
+    const auto lane_envs = AssignLanes(*graph, flow_json, settings, factory);
+
+    std::signal(SIGINT, RequestStop);
+    std::signal(SIGTERM, RequestStop);
+
+    SPDLOG_INFO("Running '{0}' with {1} nodes", flow_file.string(), graph->Size());
+
+    graph->Visit([](const auto& node) { node->Start(); });
+    graph->Run();
+
+    std::atomic_bool finished = false;
+    std::thread waiter([&] {
+        env->Wait();
+        for (const auto& lane_env : lane_envs)
+        {
+            lane_env->Wait();
+        }
+
+        finished = true;
+    });
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool timed_out      = false;
+    while (!finished && !stop_requested)
+    {
+        if (timeout.count() > 0 && std::chrono::steady_clock::now() >= deadline)
+        {
+            timed_out = true;
+            break;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    if (timed_out)
+    {
+        SPDLOG_WARN("Stopping flow after the {0}s timeout", timeout.count());
+    }
+    else if (!finished)
+    {
+        SPDLOG_INFO("Stopping flow");
+    }
+
+    // Stopping the nodes ends any that keep scheduling work, so the executor drains and the waiter returns.
+    graph->Visit([](const auto& node) { node->Stop(); });
+    waiter.join();
+
+    graph->Clear();
+    for (auto it = modules.rbegin(); it != modules.rend(); ++it)
+    {
+        (*it)->Unload();
+    }
+
+    return timed_out ? timeout_exit_code : EXIT_SUCCESS;
+}
+} // namespace
 
 int main(int argc, char** argv)
 {
     std::string filename;
+    std::string record_file;
+    std::string replay_file;
+    std::string replay_report;
+    bool replay_fast = false;
 
 #ifndef FLOW_WINDOWS
     // clang-format off
     cxxopts::Options options("FlowEditor");
     options.add_options()
         ("f,flow", "Flow file to open", cxxopts::value<std::string>())
+        ("record", "Record the session input to a file", cxxopts::value<std::string>())
+        ("replay", "Replay a recorded session and exit", cxxopts::value<std::string>())
+        ("replay-fast", "Replay frames back to back instead of at the recorded pace")
+        ("replay-report", "File to write the replay frame time statistics to", cxxopts::value<std::string>())
+        ("headless", "Run the flow without a UI and exit when it completes")
+        ("m,modules", "Modules directory used in headless mode", cxxopts::value<std::string>())
+        ("t,threads", "Headless executor threads, 0 for the flow's own setting", cxxopts::value<std::size_t>()->default_value("0"))
+        ("timeout", "Headless run time limit in seconds, 0 for none", cxxopts::value<int>()->default_value("0"))
         ("l,log_level", "Logging level [trace = 0, debug = 1, info = 2, warn = 3, err = 4, critical = 5, off = 6]", cxxopts::value<int>())
         ("h,help", "Print usage");
     // clang-format on
@@ -44,14 +257,65 @@ int main(int argc, char** argv)
         filename = result["flow"].as<std::string>();
     }
 
+    if (result.count("record"))
+    {
+        record_file = result["record"].as<std::string>();
+    }
+
+    if (result.count("replay"))
+    {
+        replay_file   = result["replay"].as<std::string>();
+        replay_fast   = result.count("replay-fast") != 0;
+        replay_report = result.count("replay-report") ? result["replay-report"].as<std::string>() : "";
+    }
+
     if (result.count("log_level"))
     {
         spdlog::set_level(static_cast<spdlog::level::level_enum>(result["log_level"].as<int>()));
     }
+
+    if (result.count("headless"))
+    {
+        if (filename.empty())
+        {
+            std::cerr << "A flow file is required in headless mode" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        const std::filesystem::path modules_path = result.count("modules")
+                                                       ? std::filesystem::path(result["modules"].as<std::string>())
+                                                       : flow::ui::FileExplorer::GetExecutablePath() / "modules";
+
+        return RunHeadless(filename, modules_path, result["threads"].as<std::size_t>(),
+                           std::chrono::seconds(std::max(result["timeout"].as<int>(), 0)));
+    }
 #endif
 
     flow::ui::Editor app(filename);
 
+    if (!replay_file.empty())
+    {
+        using flow::ui::ReplayPace;
+        app.ReplaySession(replay_file, replay_fast ? ReplayPace::Unthrottled : ReplayPace::Recorded);
+        app.OnReplayFinished = [&](const flow::ui::ReplayStats& stats) {
+            SPDLOG_INFO("Replayed {0} frames: mean {1:.2f}ms, p50 {2:.2f}ms, p95 {3:.2f}ms, p99 {4:.2f}ms, "
+                        "max {5:.2f}ms",
+                        stats.Frames, stats.Mean, stats.P50, stats.P95, stats.P99, stats.Max);
+
+            if (!replay_report.empty())
+            {
+                std::ofstream out(replay_report);
+                out << flow::ui::json(stats).dump(4) << std::endl;
+            }
+
+            app.RequestExit();
+        };
+    }
+    else if (!record_file.empty())
+    {
+        app.RecordSession(record_file);
+    }
+
     app.LoadFonts = [](flow::ui::Config& config) {
         config.DefaultFont    = flow::ui::LoadFont("fonts/DroidSans.ttf", 18.f);
         config.NodeHeaderFont = flow::ui::LoadFont("fonts/DroidSans.ttf", 20.f);
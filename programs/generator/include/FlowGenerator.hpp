@@ -0,0 +1,92 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include <flow/core/Env.hpp>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace flow::synthetic
+{
+using json = nlohmann::json;
+
+/**
+ * @brief The shape of the connections between generated nodes.
+ */
+enum class Topology : std::uint8_t
+{
+    /// Every node takes its input from the node before it.
+    Chain,
+
+    /// Every node takes its inputs from any of the nodes shortly before it.
+    DAG,
+
+    /// Nodes are split into layers that take their inputs from the previous layer.
+    Layered,
+};
+
+/**
+ * @brief Parses a topology name.
+ * @param name One of "chain", "dag" or "layered".
+ * @returns The topology.
+ * @throws std::invalid_argument if the name is unknown.
+ */
+Topology ParseTopology(std::string_view name);
+
+/**
+ * @brief Options controlling the generated flow.
+ */
+struct GeneratorOptions
+{
+    /// Seed of the random generator, the same options and seed always produce the same flow.
+    std::uint64_t Seed = 0;
+
+    /// Total number of nodes.
+    std::size_t Nodes = 1000;
+
+    /// Shape of the connections within each lane.
+    Topology Shape = Topology::DAG;
+
+    /// Number of independent lanes the nodes are split into, each lane uses a single port type.
+    std::size_t Lanes = 4;
+
+    /// Smallest number of inputs per node.
+    std::size_t MinFanIn = 1;
+
+    /// Largest number of inputs per node, at most MaxInputs.
+    std::size_t MaxFanIn = 2;
+
+    /// How strongly nodes that already have outputs connected are preferred as inputs, 0 picks uniformly.
+    double FanOutSkew = 0.0;
+
+    /// How many of the previous nodes a DAG node can take its inputs from.
+    std::size_t Locality = 32;
+
+    /// Number of nodes in each layer of a layered flow.
+    std::size_t LayerWidth = 16;
+
+    /// Number of comments placed around runs of nodes.
+    std::size_t Comments = 0;
+
+    /// Short names of the port types to draw lanes from, see TypeNames. Every type is used if empty.
+    std::vector<std::string> Types;
+};
+
+/**
+ * @brief Generates a flow of synthetic nodes in the same format the editor saves .flow files in.
+ *
+ * @param options The generator options.
+ * @param env The environment to create the nodes in. The synthetic node classes must be registered to its factory.
+ *
+ * @returns The flow JSON.
+ * @throws std::invalid_argument if the options are inconsistent.
+ */
+json GenerateFlow(const GeneratorOptions& options, const std::shared_ptr<Env>& env);
+} // namespace flow::synthetic
@@ -0,0 +1,123 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include <flow/core/Node.hpp>
+#include <flow/core/NodeData.hpp>
+#include <flow/core/NodeFactory.hpp>
+#include <flow/core/TypeName.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace flow::synthetic
+{
+/// The largest number of inputs a synthetic node can have.
+inline constexpr std::size_t MaxInputs = 4;
+
+/// The port types synthetic nodes are generated for, matching the input types registered by the editor.
+using Types = std::tuple<bool, float, double, std::int8_t, std::int16_t, std::int32_t, std::int64_t, std::uint8_t,
+                         std::uint16_t, std::uint32_t, std::uint64_t, std::string, std::chrono::milliseconds,
+                         std::filesystem::path>;
+
+/// Short names of the synthetic port types, in the same order as Types.
+inline constexpr std::array<std::string_view, std::tuple_size_v<Types>> TypeNames = {
+    "bool",   "float",  "double", "int8",   "int16",  "int32",        "int64",
+    "uint8",  "uint16", "uint32", "uint64", "string", "milliseconds", "path",
+};
+
+/**
+ * @brief Gets the key of an input port of a synthetic node.
+ * @param index The index of the input.
+ * @returns The input key.
+ */
+inline std::string InputKey(std::size_t index) { return "in" + std::to_string(index); }
+
+/**
+ * @brief Node with a fixed number of inputs and one output of the same type, used to build synthetic flows.
+ *
+ * @tparam T The type of every port of the node.
+ * @tparam Inputs The number of inputs of the node.
+ */
+template<typename T, std::size_t Inputs>
+class SyntheticNode : public Node
+{
+  public:
+    explicit SyntheticNode(const std::string& uuid_str, const std::string& name, std::shared_ptr<Env> env)
+        : Node(uuid_str, flow::TypeName_v<SyntheticNode>, name, std::move(env))
+    {
+        for (std::size_t i = 0; i < Inputs; ++i)
+        {
+            AddInput<T>(IndexableName{InputKey(i)}, "Synthetic input");
+        }
+
+        AddOutput<T>("out", "Synthetic output");
+    }
+
+    virtual ~SyntheticNode() = default;
+
+  protected:
+    void Compute() override
+    {
+        for (std::size_t i = 0; i < Inputs; ++i)
+        {
+            if (auto data = GetInputData<T>(IndexableName{InputKey(i)}))
+            {
+                SetOutputData("out", data);
+                return;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Calls a function for every synthetic node class.
+ *
+ * @param func A template lambda taking the port type and input count as template parameters and the index of the type
+ *             in Types as its argument.
+ */
+template<typename F>
+void ForEachClass(F&& func)
+{
+    const auto for_type = [&]<typename T, std::size_t... Is>(std::size_t type_index, std::index_sequence<Is...>) {
+        (func.template operator()<T, Is + 1>(type_index), ...);
+    };
+
+    [&]<std::size_t... Ts>(std::index_sequence<Ts...>) {
+        (for_type.template operator()<std::tuple_element_t<Ts, Types>>(Ts, std::make_index_sequence<MaxInputs>{}),
+         ...);
+    }(std::make_index_sequence<std::tuple_size_v<Types>>{});
+}
+
+/**
+ * @brief Registers every synthetic node class.
+ * @param factory The factory to register the classes to.
+ */
+inline void RegisterNodes(const std::shared_ptr<NodeFactory>& factory)
+{
+    ForEachClass([&]<typename T, std::size_t Inputs>(std::size_t type_index) {
+        const std::string friendly_name = std::string(TypeNames[type_index]) + " x" + std::to_string(Inputs);
+        factory->RegisterNodeClass<SyntheticNode<T, Inputs>>("Synthetic", friendly_name);
+    });
+}
+
+/**
+ * @brief Unregisters every synthetic node class.
+ * @param factory The factory the classes were registered to.
+ */
+inline void UnregisterNodes(const std::shared_ptr<NodeFactory>& factory)
+{
+    ForEachClass([&]<typename T, std::size_t Inputs>(std::size_t) {
+        factory->UnregisterNodeClass<SyntheticNode<T, Inputs>>("Synthetic");
+    });
+}
+} // namespace flow::synthetic
@@ -0,0 +1,349 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "FlowGenerator.hpp"
+
+#include "SyntheticNodes.hpp"
+
+#include <flow/core/Graph.hpp>
+#include <flow/core/UUID.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace flow::synthetic
+{
+namespace
+{
+constexpr float node_spacing_x          = 250.f;
+constexpr float node_spacing_y          = 150.f;
+constexpr float node_width              = 200.f;
+constexpr float node_height             = 100.f;
+constexpr float comment_margin          = 40.f;
+constexpr std::size_t max_comment_nodes = 16;
+
+/**
+ * @brief Random numbers derived only from std::mt19937_64, whose output is fully specified, so a seed produces the same
+ * flow with every standard library. The standard distributions are implementation defined.
+ */
+class Random
+{
+  public:
+    explicit Random(std::uint64_t seed) : _engine{seed} {}
+
+    std::uint64_t Next() { return _engine(); }
+
+    std::size_t Index(std::size_t count) { return count == 0 ? 0 : static_cast<std::size_t>(_engine() % count); }
+
+    std::size_t Range(std::size_t min, std::size_t max) { return min + Index(max - min + 1); }
+
+    double Unit() { return static_cast<double>(_engine() >> 11) * 0x1.0p-53; }
+
+  private:
+    std::mt19937_64 _engine;
+};
+
+std::string MakeUUID(Random& random)
+{
+    std::array<std::uint8_t, 16> bytes;
+    for (std::size_t i = 0; i < bytes.size(); i += 8)
+    {
+        const std::uint64_t value = random.Next();
+        for (std::size_t j = 0; j < 8; ++j)
+        {
+            bytes[i + j] = static_cast<std::uint8_t>(value >> (j * 8));
+        }
+    }
+
+    // Mark as a version 4 UUID so it is indistinguishable from the ones the editor creates.
+    bytes[6] = static_cast<std::uint8_t>((bytes[6] & 0x0F) | 0x40);
+    bytes[8] = static_cast<std::uint8_t>((bytes[8] & 0x3F) | 0x80);
+
+    constexpr std::string_view digits = "0123456789abcdef";
+
+    std::string uuid;
+    uuid.reserve(36);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+    {
+        if (i == 4 || i == 6 || i == 8 || i == 10) uuid.push_back('-');
+        uuid.push_back(digits[bytes[i] >> 4]);
+        uuid.push_back(digits[bytes[i] & 0x0F]);
+    }
+
+    return uuid;
+}
+
+struct GeneratedNode
+{
+    std::string ID;
+    std::size_t Lane;
+    float X;
+    float Y;
+};
+
+struct Lane
+{
+    std::size_t First;
+    std::size_t Count;
+};
+
+/**
+ * @brief Picks an input node from a range of candidates, preferring nodes with more outputs connected by the skew.
+ */
+std::size_t PickParent(Random& random, std::size_t first, std::size_t last, const std::vector<std::size_t>& fan_out,
+                       double skew, const std::vector<std::size_t>& excluded)
+{
+    const auto is_excluded = [&](std::size_t i) {
+        return std::find(excluded.begin(), excluded.end(), i) != excluded.end();
+    };
+
+    double total = 0.0;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        if (!is_excluded(i)) total += std::pow(static_cast<double>(fan_out[i] + 1), skew);
+    }
+
+    double target      = random.Unit() * total;
+    std::size_t picked = last;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        if (is_excluded(i)) continue;
+
+        picked = i;
+        target -= std::pow(static_cast<double>(fan_out[i] + 1), skew);
+        if (target < 0.0) break;
+    }
+
+    return picked;
+}
+
+std::vector<std::size_t> ResolveTypes(const std::vector<std::string>& names)
+{
+    std::vector<std::size_t> types;
+    if (names.empty())
+    {
+        for (std::size_t i = 0; i < TypeNames.size(); ++i)
+        {
+            types.push_back(i);
+        }
+
+        return types;
+    }
+
+    for (const auto& name : names)
+    {
+        auto found = std::find(TypeNames.begin(), TypeNames.end(), name);
+        if (found == TypeNames.end())
+        {
+            throw std::invalid_argument("Unknown synthetic port type: " + name);
+        }
+
+        types.push_back(static_cast<std::size_t>(std::distance(TypeNames.begin(), found)));
+    }
+
+    return types;
+}
+
+void Validate(const GeneratorOptions& options)
+{
+    if (options.Lanes == 0) throw std::invalid_argument("At least one lane is required");
+    if (options.MinFanIn == 0) throw std::invalid_argument("Nodes need at least one input");
+    if (options.MinFanIn > options.MaxFanIn) throw std::invalid_argument("Minimum fan-in exceeds the maximum");
+    if (options.MaxFanIn > MaxInputs)
+    {
+        throw std::invalid_argument("Fan-in is limited to " + std::to_string(MaxInputs) + " inputs");
+    }
+    if (options.Locality == 0 || options.LayerWidth == 0)
+    {
+        throw std::invalid_argument("Locality and layer width must be positive");
+    }
+    if (options.FanOutSkew < 0.0) throw std::invalid_argument("Fan-out skew must not be negative");
+}
+} // namespace
+
+Topology ParseTopology(std::string_view name)
+{
+    if (name == "chain") return Topology::Chain;
+    if (name == "dag") return Topology::DAG;
+    if (name == "layered") return Topology::Layered;
+
+    throw std::invalid_argument("Unknown topology: " + std::string(name));
+}
+
+json GenerateFlow(const GeneratorOptions& options, const std::shared_ptr<Env>& env)
+{
+    Validate(options);
+
+    const auto types = ResolveTypes(options.Types);
+
+    std::vector<std::array<std::string, MaxInputs>> class_names(TypeNames.size());
+    ForEachClass([&]<typename T, std::size_t Inputs>(std::size_t type_index) {
+        class_names[type_index][Inputs - 1] = std::string(flow::TypeName_v<SyntheticNode<T, Inputs>>);
+    });
+
+    Random random(options.Seed);
+    auto graph = std::make_shared<Graph>("Generated", env);
+
+    std::vector<GeneratedNode> nodes;
+    nodes.reserve(options.Nodes);
+
+    std::vector<Lane> lanes;
+    float lane_top = 0.f;
+
+    for (std::size_t lane = 0; lane < options.Lanes; ++lane)
+    {
+        const std::size_t count = options.Nodes / options.Lanes + (lane < options.Nodes % options.Lanes ? 1 : 0);
+        if (count == 0) break;
+
+        const std::size_t first = nodes.size();
+        const std::size_t type  = types[random.Index(types.size())];
+        const auto columns      = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+
+        lanes.push_back({first, count});
+
+        std::vector<flow::UUID> ids;
+        std::vector<std::size_t> fan_out(count, 0);
+        std::vector<std::size_t> parents;
+        std::size_t rows = 0;
+
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const std::size_t fan_in =
+                options.Shape == Topology::Chain ? 1 : random.Range(options.MinFanIn, options.MaxFanIn);
+
+            std::size_t candidates_first = 0;
+            std::size_t candidates_last  = 0;
+            std::size_t column           = k % columns;
+            std::size_t row              = k / columns;
+
+            switch (options.Shape)
+            {
+            case Topology::Chain:
+                candidates_first = k == 0 ? 0 : k - 1;
+                candidates_last  = k;
+                break;
+            case Topology::DAG:
+                candidates_first = k > options.Locality ? k - options.Locality : 0;
+                candidates_last  = k;
+                break;
+            case Topology::Layered:
+            {
+                const std::size_t layer = k / options.LayerWidth;
+                candidates_first        = layer == 0 ? 0 : (layer - 1) * options.LayerWidth;
+                candidates_last         = layer * options.LayerWidth;
+                column                  = layer;
+                row                     = k % options.LayerWidth;
+                break;
+            }
+            }
+
+            rows = std::max(rows, row + 1);
+
+            const std::string& class_name = class_names[type][fan_in - 1];
+            auto node = env->GetFactory()->CreateNode(class_name, flow::UUID{MakeUUID(random)},
+                                                      "Node " + std::to_string(lane) + "." + std::to_string(k), env);
+            if (!node)
+            {
+                throw std::runtime_error("Synthetic node class is not registered: " + class_name);
+            }
+
+            graph->AddNode(node);
+            ids.push_back(node->ID());
+            nodes.push_back({std::string(node->ID()), lane, static_cast<float>(column) * node_spacing_x,
+                             lane_top + static_cast<float>(row) * node_spacing_y});
+
+            parents.clear();
+            const std::size_t available = candidates_last - candidates_first;
+            for (std::size_t input = 0; input < std::min(fan_in, available); ++input)
+            {
+                const std::size_t parent =
+                    PickParent(random, candidates_first, candidates_last, fan_out, options.FanOutSkew, parents);
+                parents.push_back(parent);
+                ++fan_out[parent];
+
+                graph->ConnectNodes(ids[parent], IndexableName{"out"}, node->ID(),
+                                    IndexableName{InputKey(input)});
+            }
+        }
+
+        lane_top += static_cast<float>(rows + 2) * node_spacing_y;
+    }
+
+    std::vector<json> comments_json;
+    for (std::size_t i = 0; i < options.Comments && !nodes.empty(); ++i)
+    {
+        const auto& lane         = lanes[nodes[random.Index(nodes.size())].Lane];
+        const std::size_t first  = lane.First + random.Index(lane.Count);
+        const std::size_t length = std::min(random.Range(2, max_comment_nodes), lane.First + lane.Count - first);
+
+        float min_x = nodes[first].X, min_y = nodes[first].Y, max_x = min_x, max_y = min_y;
+        for (std::size_t n = first; n < first + length; ++n)
+        {
+            min_x = std::min(min_x, nodes[n].X);
+            min_y = std::min(min_y, nodes[n].Y);
+            max_x = std::max(max_x, nodes[n].X);
+            max_y = std::max(max_y, nodes[n].Y);
+        }
+
+        comments_json.push_back({
+            {"position", {{"x", min_x - comment_margin}, {"y", min_y - comment_margin}}},
+            {"size",
+             {{"x", max_x - min_x + node_width + 2 * comment_margin},
+              {"y", max_y - min_y + node_height + 2 * comment_margin}}},
+            {"comment", "Comment " + std::to_string(i)},
+        });
+    }
+
+    json graph_json = *graph;
+    graph->Clear();
+
+    // The graph stores nodes and connections in hash maps, so they are put back into generation order to keep the
+    // output identical for a given seed.
+    std::unordered_map<std::string, json> nodes_by_id;
+    for (json& node_json : graph_json["nodes"])
+    {
+        nodes_by_id.emplace(node_json["id"].get<std::string>(), std::move(node_json));
+    }
+
+    std::vector<json> nodes_json;
+    nodes_json.reserve(nodes.size());
+    for (const auto& node : nodes)
+    {
+        json& node_json       = nodes_by_id.at(node.ID);
+        node_json["position"] = {{"x", node.X}, {"y", node.Y}};
+        nodes_json.push_back(std::move(node_json));
+    }
+
+    // Connection IDs are random, so they are dropped before sorting and replaced with seeded ones.
+    std::vector<std::pair<std::string, json>> sorted_connections;
+    for (json& connection_json : graph_json["connections"])
+    {
+        const bool has_id = connection_json.erase("id") != 0;
+        std::string key   = connection_json.dump();
+        if (has_id) connection_json["id"] = nullptr;
+
+        sorted_connections.emplace_back(std::move(key), std::move(connection_json));
+    }
+
+    std::sort(sorted_connections.begin(), sorted_connections.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<json> connections_json;
+    connections_json.reserve(sorted_connections.size());
+    for (auto& [_, connection_json] : sorted_connections)
+    {
+        if (connection_json.contains("id")) connection_json["id"] = MakeUUID(random);
+        connections_json.push_back(std::move(connection_json));
+    }
+
+    return {
+        {"nodes", std::move(nodes_json)},
+        {"connections", std::move(connections_json)},
+        {"comments", std::move(comments_json)},
+    };
+}
+} // namespace flow::synthetic
@@ -0,0 +1,98 @@
+#include "FlowGenerator.hpp"
+#include "SyntheticNodes.hpp"
+
+#include <cxxopts.hpp>
+#include <flow/core/Env.hpp>
+#include <flow/core/NodeFactory.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    // clang-format off
+    cxxopts::Options options("flow-generate", "Generates synthetic .flow files for benchmarking and profiling");
+    options.add_options()
+        ("o,output", "The .flow file to write", cxxopts::value<std::string>())
+        ("n,nodes", "Total number of nodes", cxxopts::value<std::size_t>()->default_value("1000"))
+        ("s,seed", "Seed of the random generator", cxxopts::value<std::uint64_t>()->default_value("0"))
+        ("t,topology", "Shape of the flow [chain, dag, layered]", cxxopts::value<std::string>()->default_value("dag"))
+        ("lanes", "Number of lanes, each with one port type", cxxopts::value<std::size_t>()->default_value("4"))
+        ("min-fan-in", "Smallest number of inputs per node", cxxopts::value<std::size_t>()->default_value("1"))
+        ("max-fan-in", "Largest number of inputs per node", cxxopts::value<std::size_t>()->default_value("2"))
+        ("fan-out-skew", "Preference for nodes that fan out", cxxopts::value<double>()->default_value("0"))
+        ("locality", "Inputs window of DAG nodes", cxxopts::value<std::size_t>()->default_value("32"))
+        ("layer-width", "Nodes per layer of a layered flow", cxxopts::value<std::size_t>()->default_value("16"))
+        ("comments", "Number of comments", cxxopts::value<std::size_t>()->default_value("0"))
+        ("types", "Port types to draw lanes from, all if not set", cxxopts::value<std::vector<std::string>>())
+        ("h,help", "Print usage");
+    // clang-format on
+
+    cxxopts::ParseResult result;
+
+    try
+    {
+        result = options.parse(argc, argv);
+    }
+    catch (const cxxopts::exceptions::exception& e)
+    {
+        std::cerr << "Caught exception while parsing arguments: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (result.count("help") || !result.count("output"))
+    {
+        std::cerr << options.help() << std::endl;
+        return result.count("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    auto factory = std::make_shared<flow::NodeFactory>();
+    flow::synthetic::RegisterNodes(factory);
+    auto env = flow::Env::Create(factory);
+
+    flow::synthetic::json flow_json;
+    try
+    {
+        flow::synthetic::GeneratorOptions generator_options;
+        generator_options.Seed       = result["seed"].as<std::uint64_t>();
+        generator_options.Nodes      = result["nodes"].as<std::size_t>();
+        generator_options.Shape      = flow::synthetic::ParseTopology(result["topology"].as<std::string>());
+        generator_options.Lanes      = result["lanes"].as<std::size_t>();
+        generator_options.MinFanIn   = result["min-fan-in"].as<std::size_t>();
+        generator_options.MaxFanIn   = result["max-fan-in"].as<std::size_t>();
+        generator_options.FanOutSkew = result["fan-out-skew"].as<double>();
+        generator_options.Locality   = result["locality"].as<std::size_t>();
+        generator_options.LayerWidth = result["layer-width"].as<std::size_t>();
+        generator_options.Comments   = result["comments"].as<std::size_t>();
+        if (result.count("types"))
+        {
+            generator_options.Types = result["types"].as<std::vector<std::string>>();
+        }
+
+        flow_json = flow::synthetic::GenerateFlow(generator_options, env);
+    }
+    catch (const std::exception& e)
+    {
+        SPDLOG_CRITICAL("Failed to generate flow: {}", e.what());
+        return EXIT_FAILURE;
+    }
+
+    const auto output = result["output"].as<std::string>();
+    std::ofstream out(output);
+    if (!out)
+    {
+        SPDLOG_CRITICAL("Failed to open '{}' for writing", output);
+        return EXIT_FAILURE;
+    }
+
+    out << flow_json.dump(4) << std::endl;
+
+    SPDLOG_INFO("Wrote {} nodes and {} connections to '{}'", flow_json["nodes"].size(),
+                flow_json["connections"].size(), output);
+
+    return EXIT_SUCCESS;
+}
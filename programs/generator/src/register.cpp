@@ -0,0 +1,23 @@
+#include "SyntheticNodes.hpp"
+
+#include <flow/core/NodeFactory.hpp>
+
+#ifdef FLOW_WINDOWS
+#ifdef FLOW_SYNTHETIC_EXPORT
+#define FLOW_SYNTHETIC_API __declspec(dllexport) FLOW_CORE_CALL
+#else
+#define FLOW_SYNTHETIC_API __declspec(dllimport) FLOW_CORE_CALL
+#endif
+#else
+#define FLOW_SYNTHETIC_API
+#endif
+
+extern "C"
+{
+    namespace flow::synthetic
+    {
+    void FLOW_SYNTHETIC_API RegisterModule(std::shared_ptr<flow::NodeFactory> factory) { RegisterNodes(factory); }
+
+    void FLOW_SYNTHETIC_API UnregisterModule(std::shared_ptr<flow::NodeFactory> factory) { UnregisterNodes(factory); }
+    } // namespace flow::synthetic
+}
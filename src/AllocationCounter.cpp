@@ -0,0 +1,50 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "AllocationCounter.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <cassert>
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+// Constant initialised, so allocations made before any dynamic initialisation are counted safely.
+constinit std::atomic_size_t allocation_count = 0;
+} // namespace
+
+void CountAllocation() noexcept { allocation_count.fetch_add(1, std::memory_order_relaxed); }
+
+std::size_t GetAllocationCount() noexcept { return allocation_count.load(std::memory_order_relaxed); }
+
+AllocationCounter::AllocationCounter(std::size_t settle_frames)
+    : _settle_frames{settle_frames}, _last_allocations{GetAllocationCount()}, _on_regression{[](std::size_t count) {
+          SPDLOG_ERROR("{0} heap allocation(s) in a steady state frame", count);
+          assert(count == 0 && "Steady state frames must not allocate");
+      }}
+{
+}
+
+std::size_t AllocationCounter::EndFrame(bool steady)
+{
+    const std::size_t total       = GetAllocationCount();
+    const std::size_t allocations = total - _last_allocations;
+
+    // Ending the frame can allocate itself, e.g. when logging, so the count of the next frame starts after it.
+    _steady_frames = steady ? _steady_frames + 1 : 0;
+    if (_steady_frames > _settle_frames && allocations != 0 && _on_regression) _on_regression(allocations);
+
+    _last_allocations = GetAllocationCount();
+    return allocations;
+}
+
+AllocationCounter& GetAllocationCounter()
+{
+    static AllocationCounter counter;
+    return counter;
+}
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,82 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "ComputeStats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <numeric>
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+std::int64_t NowNanoseconds() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace
+
+void LatencyHistogram::Record(std::chrono::nanoseconds latency) noexcept
+{
+    const auto micros = static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count() / 1000, 0));
+    const auto bucket = std::min<std::size_t>(std::bit_width(micros), BucketCount - 1);
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Buckets LatencyHistogram::Snapshot() const noexcept
+{
+    Buckets buckets{};
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    }
+
+    return buckets;
+}
+
+void LatencyHistogram::Reset() noexcept
+{
+    for (auto& bucket : _buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::chrono::microseconds LatencyHistogram::BucketUpperBound(std::size_t bucket) noexcept
+{
+    return std::chrono::microseconds{(std::int64_t{1} << bucket) - 1};
+}
+
+std::chrono::microseconds LatencyHistogram::Percentile(const Buckets& buckets, double percentile) noexcept
+{
+    const std::uint64_t total = std::accumulate(buckets.begin(), buckets.end(), std::uint64_t{0});
+    if (total == 0) return std::chrono::microseconds::zero();
+
+    const auto target     = static_cast<std::uint64_t>(percentile * static_cast<double>(total - 1)) + 1;
+    std::uint64_t counted = 0;
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        counted += buckets[i];
+        if (counted >= target) return BucketUpperBound(i);
+    }
+
+    return BucketUpperBound(BucketCount - 1);
+}
+
+void NodeComputeStats::BeginCompute() noexcept
+{
+    Calls.fetch_add(1, std::memory_order_relaxed);
+    ComputeStart.store(NowNanoseconds(), std::memory_order_relaxed);
+}
+
+void NodeComputeStats::EndCompute() noexcept
+{
+    const std::int64_t start = ComputeStart.exchange(0, std::memory_order_relaxed);
+    if (start == 0) return;
+
+    Latency.Record(std::chrono::nanoseconds{NowNanoseconds() - start});
+}
+
+FLOW_UI_NAMESPACE_END
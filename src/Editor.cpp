@@ -3,13 +3,20 @@
 
 #include "Editor.hpp"
 
+#include "AllocationCounter.hpp"
 #include "Config.hpp"
 #include "EditorNodes.hpp"
+#include "Executor.hpp"
+#include "FramePacer.hpp"
+#include "Profiler.hpp"
+#include "ValueFormatter.hpp"
 #include "ViewFactory.hpp"
 #include "Window.hpp"
 #include "utilities/Conversions.hpp"
+#include "windows/ExecutorWindow.hpp"
 #include "windows/ModuleManagerWindow.hpp"
 #include "windows/NodeExplorerWindow.hpp"
+#include "windows/ProfilerWindow.hpp"
 #include "windows/PropertyWindow.hpp"
 #include "windows/ShortcutsWindow.hpp"
 
@@ -71,6 +78,25 @@ Editor::Editor(const std::string& initial_file)
     _params.dockingParams.mainDockSpaceNodeFlags = ImGuiDockNodeFlags_AutoHideTabBar;
 
     _params.callbacks.PreNewFrame = [=, this] {
+#ifdef FLOW_UI_ENABLE_PROFILER
+        GetProfiler().BeginFrame();
+#endif
+        // Idling is decided per frame, so runtime activity and animations hold the full frame rate.
+        const auto& config             = GetConfig();
+        const bool may_idle            = GetFramePacer().BeginFrame();
+        _params.fpsIdling.enableIdling = config.AdaptiveFramePacing && may_idle && !_replayer;
+        _params.fpsIdling.fpsIdle      = config.IdleFrameRate;
+
+        // An idle editor is in a steady state, so the frame before this one should not have allocated.
+        GetAllocationCounter().EndFrame(may_idle && !_replayer);
+        GetFrameArena().Reset();
+        OnNewFrame();
+
+        for (auto& window : _windows)
+        {
+            window->Update();
+        }
+
         HandleInput();
 
         OnGraphWindowAdded.Broadcast();
@@ -78,14 +104,21 @@ Editor::Editor(const std::string& initial_file)
 
         OnGraphWindowRemoved.Broadcast();
         OnGraphWindowRemoved.UnbindAll();
+
+        if (_replayer && _replayer->IsFinished())
+        {
+            const auto stats = _replayer->GetStats();
+            _replayer.reset();
+            OnReplayFinished(stats);
+        }
     };
 
     _params.imGuiWindowParams.showMenu_View_Themes = false;
-    _params.fpsIdling.enableIdling                 = false;
 
     _params.callbacks.SetupImGuiStyle = [&] {
         SetupStyle(GetStyle());
         utility::to_ImGuiStyle(GetStyle());
+        _factory->GetTypeRegistry().Refresh();
 
         auto& imgui_style                      = ImGui::GetStyle();
         imgui_style.CircleTessellationMaxError = 0.1f;
@@ -104,24 +137,24 @@ Editor::Editor(const std::string& initial_file)
 
 void Editor::Init(const std::string& initial_file)
 {
-    _factory->OnNodeClassUnregistered.Bind("Unregister", [&](std::string_view class_name) {
-        for (const auto& [_, gw] : _graph_windows)
+    if (const auto render_affinity = GetConfig().RenderThreadAffinity; render_affinity != 0)
+    {
+        if (!SetCurrentThreadScheduling(render_affinity, ThreadPriority::Normal))
         {
-            const auto& graph = gw->GetGraph();
+            SPDLOG_WARN("Could not pin the render thread to CPU mask {0:#x}", render_affinity);
+        }
+    }
 
-            std::set<flow::UUID> nodes_to_remove;
-            graph->Visit([&](const auto& node) {
-                if (node->GetClass() == class_name)
-                {
-                    nodes_to_remove.insert(node->ID());
-                }
-            });
+    // Graphs without threads of their own run on the shared environment, whose workers keep off the render CPUs too.
+    SetExecutorScheduling(*_env, flow::EnvSettings{}.max_threads, 0, ThreadPriority::Normal);
 
-            for (const auto& id : nodes_to_remove)
+    _factory->OnNodeClassUnregistered.Bind("Unregister", [&](std::string_view class_name) {
+        const std::string name{class_name};
+        for (const auto& [_, gw] : _graph_windows)
+        {
+            if (const auto removed = gw->RemoveNodesOfClass(name); removed != 0)
             {
-                graph->RemoveNodeByID(id);
-                ed::SetCurrentEditor(std::bit_cast<ed::EditorContext*>(gw->GetEditorContext().get()));
-                ed::DeleteNode(std::hash<UUID>{}(id));
+                SPDLOG_INFO("Removed {} '{}' node(s) from '{}'", removed, name, gw->GetName());
             }
         }
     });
@@ -152,6 +185,67 @@ void Editor::Init(const std::string& initial_file)
     _factory->RegisterInputType<std::chrono::years>(std::chrono::years::zero());
     _factory->RegisterInputType<std::filesystem::path>(std::filesystem::path(""));
 
+    const auto format_value    = [](const auto& value, FormatBuffer& buffer) { buffer.Format("{}", value); };
+    const auto format_duration = [](std::string_view suffix) {
+        return [=](const auto& value, FormatBuffer& buffer) { buffer.Format("{}{}", value.count(), suffix); };
+    };
+
+    _factory->RegisterFormatter<bool>([](const bool& value, FormatBuffer& buffer) {
+        buffer.Append(value ? "true" : "false");
+    });
+    _factory->RegisterFormatter<float>(format_value);
+    _factory->RegisterFormatter<double>(format_value);
+    _factory->RegisterFormatter<std::int8_t>(format_value);
+    _factory->RegisterFormatter<std::int16_t>(format_value);
+    _factory->RegisterFormatter<std::int32_t>(format_value);
+    _factory->RegisterFormatter<std::int64_t>(format_value);
+    _factory->RegisterFormatter<std::uint8_t>(format_value);
+    _factory->RegisterFormatter<std::uint16_t>(format_value);
+    _factory->RegisterFormatter<std::uint32_t>(format_value);
+    _factory->RegisterFormatter<std::uint64_t>(format_value);
+    _factory->RegisterFormatter<std::string>([](const std::string& value, FormatBuffer& buffer) {
+        buffer.Append(value);
+    });
+    _factory->RegisterFormatter<std::chrono::nanoseconds>(format_duration("ns"));
+    _factory->RegisterFormatter<std::chrono::microseconds>(format_duration("us"));
+    _factory->RegisterFormatter<std::chrono::milliseconds>(format_duration("ms"));
+    _factory->RegisterFormatter<std::chrono::seconds>(format_duration("s"));
+    _factory->RegisterFormatter<std::chrono::minutes>(format_duration("min"));
+    _factory->RegisterFormatter<std::chrono::hours>(format_duration("h"));
+    _factory->RegisterFormatter<std::chrono::days>(format_duration("d"));
+    _factory->RegisterFormatter<std::chrono::months>(format_duration("mo"));
+    _factory->RegisterFormatter<std::chrono::years>(format_duration("y"));
+    _factory->RegisterFormatter<std::filesystem::path>([](const std::filesystem::path& value, FormatBuffer& buffer) {
+        if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+        {
+            buffer.Append(value.native());
+        }
+        else
+        {
+            buffer.Append(value.string());
+        }
+    });
+
+    const auto size_of = [](const auto& value) -> std::size_t { return sizeof(value); };
+
+    _factory->RegisterDataSize<bool>(size_of);
+    _factory->RegisterDataSize<float>(size_of);
+    _factory->RegisterDataSize<double>(size_of);
+    _factory->RegisterDataSize<std::int8_t>(size_of);
+    _factory->RegisterDataSize<std::int16_t>(size_of);
+    _factory->RegisterDataSize<std::int32_t>(size_of);
+    _factory->RegisterDataSize<std::int64_t>(size_of);
+    _factory->RegisterDataSize<std::uint8_t>(size_of);
+    _factory->RegisterDataSize<std::uint16_t>(size_of);
+    _factory->RegisterDataSize<std::uint32_t>(size_of);
+    _factory->RegisterDataSize<std::uint64_t>(size_of);
+    _factory->RegisterDataSize<std::string>([](const std::string& value) { return value.size(); });
+    _factory->RegisterDataSize<std::filesystem::path>([](const std::filesystem::path& value) {
+        return value.native().size() * sizeof(std::filesystem::path::value_type);
+    });
+
+    GetValueFormatter().SetViewFactory(_factory);
+
     auto node_explorer = std::make_shared<NodeExplorerWindow>(_env);
     OnActiveGraphChanged.Bind("NodeExplorer", [window = node_explorer](const auto& g) { window->SetActiveGraph(g); });
 
@@ -161,15 +255,51 @@ void Editor::Init(const std::string& initial_file)
     AddDockspace("MiscSpace", DefaultDockspace, 0.25f, DockspaceSplitDirection::Down);
 
     auto property_window = std::make_shared<PropertyWindow>(_env);
-    OnActiveGraphChanged.Bind(flow::IndexableName{property_window->GetName()},
-                              [=](const auto& g) { property_window->SetCurrentGraph(g); });
+    OnActiveGraphChanged.Bind(flow::IndexableName{property_window->GetName()}, [=, this](const auto& g) {
+        auto found = _graph_windows.find(g->ID());
+        property_window->SetCurrentGraph(found != _graph_windows.end() ? found->second : nullptr);
+    });
+
+    auto executor_window = std::make_shared<ExecutorWindow>();
+    OnActiveGraphChanged.Bind(flow::IndexableName{executor_window->GetName()}, [=, this](const auto& g) {
+        auto found = _graph_windows.find(g->ID());
+        executor_window->SetCurrentGraph(found != _graph_windows.end() ? found->second : nullptr);
+    });
+    executor_window->OnApply = [this](const auto& graph_window, const auto& settings) {
+        ChangeExecutor(graph_window, settings);
+    };
+
+    auto module_manager = std::make_shared<ModuleManagerWindow>(_env, default_modules_path);
+    module_manager->OnModuleReload = [this](const auto& class_names, const auto& reload) {
+        // Only the nodes of the reloaded module are rebuilt, with the same IDs, inputs and connections.
+        std::vector<std::pair<std::shared_ptr<GraphWindow>, std::vector<NodeSnapshot>>> detached;
+        for (const auto& [_, gw] : _graph_windows)
+        {
+            detached.emplace_back(gw, gw->DetachNodesOfClasses(class_names));
+        }
+
+        reload();
+
+        for (const auto& [gw, snapshots] : detached)
+        {
+            gw->RestoreNodes(snapshots);
+        }
+    };
 
     AddWindow(std::move(property_window), PropertyDockspace);
     AddWindow(std::move(node_explorer), "PropertySubSpace");
-    AddWindow(std::make_shared<ModuleManagerWindow>(_env, default_modules_path), "PropertySubSpace", false);
+    AddWindow(std::move(module_manager), "PropertySubSpace", false);
     AddWindow(std::make_shared<ShortcutsWindow>(), PropertyDockspace, false);
+    AddWindow(std::move(executor_window), PropertyDockspace, false);
+#ifdef FLOW_UI_ENABLE_PROFILER
+    AddWindow(std::make_shared<ProfilerWindow>(), "MiscSpace", false);
+#endif
 
-    if (!initial_file.empty())
+    if (_replay_session)
+    {
+        StartReplay();
+    }
+    else if (!initial_file.empty())
     {
         LoadFlow(initial_file);
     }
@@ -177,14 +307,24 @@ void Editor::Init(const std::string& initial_file)
     {
         CreateFlow("untitled##0");
     }
+
+    if (!_session_file.empty() && !_replay_session)
+    {
+        StartRecording();
+    }
 }
 
 void Editor::Teardown()
 {
+    StopRecording();
+    _replayer.reset();
+
     for (auto& window : _windows)
     {
         window->Teardown();
     }
+
+    GetValueFormatter().Stop();
 }
 
 void Editor::Run() { HelloImGui::Run(_params); }
@@ -196,10 +336,18 @@ void Editor::AddWindow(std::shared_ptr<Window> new_window, const std::string& do
     HelloImGui::DockableWindow dockable_window;
     dockable_window.label            = window->GetName();
     dockable_window.dockSpaceName    = dockspace;
-    dockable_window.GuiFunction      = [=] { window->Draw(); };
     dockable_window.imGuiWindowFlags = ImGuiWindowFlags_NoCollapse;
     dockable_window.isVisible        = show;
 
+#ifdef FLOW_UI_ENABLE_PROFILER
+    dockable_window.GuiFunction = [=, scope_name = GetProfiler().Intern(window->GetName())] {
+        FLOW_UI_PROFILE_SCOPE(scope_name);
+        window->Draw();
+    };
+#else
+    dockable_window.GuiFunction = [=] { window->Draw(); };
+#endif
+
     window->Init();
     HelloImGui::AddDockableWindow(std::move(dockable_window));
 }
@@ -218,8 +366,25 @@ void Editor::AddDockspace(std::string name, std::string initial_dockspace_name,
 
 void* Editor::GetContext() const noexcept { return reinterpret_cast<void*>(ImGui::GetCurrentContext()); }
 
+void Editor::RecordSession(std::filesystem::path file)
+{
+    _session_file   = std::move(file);
+    _replay_session = false;
+}
+
+void Editor::ReplaySession(std::filesystem::path file, ReplayPace pace)
+{
+    _session_file   = std::move(file);
+    _replay_pace    = pace;
+    _replay_session = true;
+}
+
+void Editor::RequestExit() { _params.appShallExit = true; }
+
 void Editor::HandleInput()
 {
+    FLOW_UI_PROFILE_SCOPE("Editor::HandleInput");
+
     if (ImGui::IsKeyChordPressed(ImGuiMod_Ctrl | ImGuiKey_N))
     {
         CreateFlow("untitled##" + std::to_string(_graph_windows.size()));
@@ -283,6 +448,21 @@ void Editor::DrawMainMenuBar()
             SaveFlow();
         }
 
+        ImGui::Separator();
+
+        if (ImGui::MenuItem("Record Session", nullptr, _recorder != nullptr, !_replayer))
+        {
+            if (_recorder)
+            {
+                StopRecording();
+            }
+            else
+            {
+                if (_session_file.empty()) _session_file = default_save_path / "session.flowrec";
+                StartRecording();
+            }
+        }
+
         ImGui::EndMenu();
     }
 
@@ -295,24 +475,52 @@ void Editor::DrawMainMenuBar()
                 ed::NavigateToContent();
             }
 
+            if (ImGui::BeginMenu("Compute Heatmap"))
+            {
+                auto& heatmap = GetConfig().NodeHeatmap;
+                if (ImGui::MenuItem("Off", nullptr, heatmap == NodeHeatmapMode::None))
+                {
+                    heatmap = NodeHeatmapMode::None;
+                }
+                if (ImGui::MenuItem("Latency (p50)", nullptr, heatmap == NodeHeatmapMode::LatencyP50))
+                {
+                    heatmap = NodeHeatmapMode::LatencyP50;
+                }
+                if (ImGui::MenuItem("Latency (p99)", nullptr, heatmap == NodeHeatmapMode::LatencyP99))
+                {
+                    heatmap = NodeHeatmapMode::LatencyP99;
+                }
+                if (ImGui::MenuItem("Call Rate", nullptr, heatmap == NodeHeatmapMode::CallRate))
+                {
+                    heatmap = NodeHeatmapMode::CallRate;
+                }
+
+                ImGui::EndMenu();
+            }
+
             ImGui::EndMenu();
         }
     }
 }
 
-std::shared_ptr<GraphWindow>& Editor::CreateFlow(std::string name)
+std::shared_ptr<GraphWindow>& Editor::CreateFlow(std::string name, const ExecutorSettings& executor)
 {
     auto found = std::find_if(_graph_windows.begin(), _graph_windows.end(),
                               [&](const auto& entry) { return entry.second->GetName() == name; });
     if (found != _graph_windows.end()) return found->second;
 
-    auto graph           = std::make_shared<flow::Graph>(name, _env);
+    // Graphs without threads of their own share the editor's environment.
+    auto env             = executor.Threads == 0 ? _env : CreateExecutor(_factory, executor);
+    auto graph           = std::make_shared<flow::Graph>(name, std::move(env));
     auto [graph_view, _] = _graph_windows.emplace(graph->ID(), std::make_shared<GraphWindow>(graph));
+    graph_view->second->SetExecutorSettings(executor);
     OnGraphWindowAdded.Bind(IndexableName{name}, [=, this, graph_view = graph_view->second] {
         HelloImGui::DockableWindow graph_window;
         graph_window.label         = name;
         graph_window.dockSpaceName = DefaultDockspace;
         graph_window.GuiFunction   = [this, gv = std::move(graph_view)]() {
+            FLOW_UI_PROFILE_SCOPE("GraphWindow::Draw");
+
             if (gv->IsActive())
             {
                 OnActiveGraphChanged.Broadcast(gv->GetGraph());
@@ -352,7 +560,7 @@ void Editor::LoadFlow(const std::filesystem::path& filename)
 
     const std::string name = file_path.filename().replace_extension("").string();
 
-    auto& graph_view = CreateFlow(name);
+    auto& graph_view = CreateFlow(name, j.value("executor", ExecutorSettings{}));
 
     graph_view->SetCurrentGraph();
     graph_view->LoadFlow(j);
@@ -388,4 +596,99 @@ void Editor::SaveFlow()
     graph_view->MarkDirty(false);
 }
 
+void Editor::StartRecording()
+{
+    if (_graph_windows.empty()) return;
+
+    auto graph_window_it = std::find_if(_graph_windows.begin(), _graph_windows.end(), [](auto& gw) {
+        return ed::GetCurrentEditor() == std::bit_cast<ed::EditorContext*>(gw.second->GetEditorContext().get());
+    });
+    if (graph_window_it == _graph_windows.end()) graph_window_it = _graph_windows.begin();
+
+    auto& graph_view = graph_window_it->second;
+
+    // Saving clears the dirty flag, but recording should not count as saving the flow.
+    const bool dirty = graph_view->IsDirty();
+    graph_view->SetCurrentGraph();
+    json flow_json = graph_view->SaveFlow();
+    graph_view->MarkDirty(dirty);
+
+    _recorder = std::make_unique<SessionRecorder>(ImGui::GetCurrentContext(),
+                                                  std::string{graph_view->GetGraph()->GetName()}, std::move(flow_json));
+    SPDLOG_INFO("Recording session to '{}'", _session_file.string());
+}
+
+void Editor::StopRecording()
+{
+    if (!_recorder) return;
+
+    const auto& recording = _recorder->GetRecording();
+    try
+    {
+        std::filesystem::create_directories(_session_file.parent_path());
+        recording.Save(_session_file);
+        SPDLOG_INFO("Saved {} recorded frames to '{}'", recording.Frames.size(), _session_file.string());
+    }
+    catch (const std::exception& e)
+    {
+        SPDLOG_ERROR("Failed to save session recording '{}': {}", _session_file.string(), e.what());
+    }
+
+    _recorder.reset();
+}
+
+void Editor::StartReplay()
+{
+    SessionRecording recording;
+    try
+    {
+        recording = SessionRecording::Load(_session_file);
+    }
+    catch (const std::exception& e)
+    {
+        SPDLOG_ERROR("Failed to load session recording '{}': {}", _session_file.string(), e.what());
+        CreateFlow("untitled##0");
+        return;
+    }
+
+    const auto& display_size = ImGui::GetIO().DisplaySize;
+    if (display_size.x != recording.DisplayWidth || display_size.y != recording.DisplayHeight)
+    {
+        SPDLOG_WARN("Session was recorded at {}x{} but the display is {}x{}, mouse input may not line up",
+                    recording.DisplayWidth, recording.DisplayHeight, display_size.x, display_size.y);
+    }
+
+    auto& graph_view = CreateFlow(recording.FlowName, recording.Flow.value("executor", ExecutorSettings{}));
+
+    graph_view->SetCurrentGraph();
+    graph_view->LoadFlow(recording.Flow);
+    graph_view->MarkDirty(false);
+    graph_view->GetGraph()->Run();
+
+    SPDLOG_INFO("Replaying {} frames from '{}'", recording.Frames.size(), _session_file.string());
+    _replayer = std::make_unique<SessionReplayer>(ImGui::GetCurrentContext(), std::move(recording), _replay_pace);
+}
+
+void Editor::ChangeExecutor(const std::shared_ptr<GraphWindow>& graph_window, const ExecutorSettings& settings)
+{
+    // Nodes keep the environment they were created with, so the flow is rebuilt on a graph with the new executor.
+    graph_window->SetCurrentGraph();
+    graph_window->SetExecutorSettings(settings);
+    json flow_json = graph_window->SaveFlow();
+
+    const std::string name = graph_window->GetName();
+    _graph_windows.erase(graph_window->GetGraph()->ID());
+
+    // The old dockable window has to be gone before the new one with the same name is added.
+    OnGraphWindowRemoved.Bind(IndexableName{name}, [=, this, flow_json = std::move(flow_json)] {
+        HelloImGui::RemoveDockableWindow(name);
+
+        auto& graph_view = CreateFlow(name, settings);
+        graph_view->SetCurrentGraph();
+        graph_view->LoadFlow(flow_json);
+        graph_view->MarkDirty(true);
+        graph_view->GetGraph()->Run();
+    });
+}
+
 FLOW_UI_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include "Config.hpp"
 #include "Core.hpp"
 #include "Texture.hpp"
+#include "ValueFormatter.hpp"
 #include "utilities/Builders.hpp"
 #include "utilities/Conversions.hpp"
 #include "views/NodeView.hpp"
@@ -14,15 +15,27 @@
 #include <imgui.h>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <any>
+#include <optional>
 
 FLOW_UI_NAMESPACE_START
 
 struct PreviewNodeView : NodeView
 {
-    PreviewNodeView(flow::SharedNode node) : NodeView(node), Node(node) {}
+    PreviewNodeView(flow::SharedNode node) : NodeView(node), Node(node)
+    {
+        auto input_it = std::find_if(Inputs.begin(), Inputs.end(), [](const auto& in) { return in->Name == "in"; });
+        if (input_it == Inputs.end()) return;
 
-    virtual ~PreviewNodeView() = default;
+        _value_key = ValuePortKey{node->ID(), (*input_it)->Key()};
+        GetValueFormatter().Acquire(*_value_key);
+    }
+
+    virtual ~PreviewNodeView()
+    {
+        if (_value_key) GetValueFormatter().Release(*_value_key);
+    }
 
     void Draw() override
     {
@@ -60,7 +73,13 @@ struct PreviewNodeView : NodeView
 
         _builder->EndHeader();
 
-        auto input_it     = std::find_if(Inputs.begin(), Inputs.end(), [](const auto& in) { return in->Name == "in"; });
+        auto input_it = std::find_if(Inputs.begin(), Inputs.end(), [](const auto& in) { return in->Name == "in"; });
+        if (input_it == Inputs.end())
+        {
+            _builder->End();
+            return;
+        }
+
         const auto& input = *input_it;
         input->SetShowLabel(false);
 
@@ -85,15 +104,23 @@ struct PreviewNodeView : NodeView
                 return;
             }
 
-            std::string data_str = data->ToString();
-            if (!data_str.empty())
+            auto& formatter = GetValueFormatter();
+            formatter.Request(*_value_key, data, input->Type());
+
+            if (auto value = formatter.Get(*_value_key); value && !value->Text.empty())
             {
                 if (should_copy)
                 {
-                    ImGui::SetClipboardText(data_str.c_str());
+                    ImGui::SetClipboardText(value->Text.c_str());
                 }
 
-                ImGui::TextUnformatted(data_str.c_str());
+                const auto preview = value->Preview();
+                ImGui::TextUnformatted(preview.data(), preview.data() + preview.size());
+
+                if (value->IsTruncated())
+                {
+                    ImGui::TextDisabled("... %zu lines, %zu bytes", value->LineCount, value->Text.size());
+                }
             }
         }
 
@@ -101,6 +128,9 @@ struct PreviewNodeView : NodeView
     }
 
     SharedNode Node;
+
+  private:
+    std::optional<ValuePortKey> _value_key;
 };
 
 FLOW_UI_NAMESPACE_END
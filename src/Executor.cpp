@@ -0,0 +1,254 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "Executor.hpp"
+
+#include "Config.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if defined(FLOW_WINDOWS)
+#include <Windows.h>
+#elif defined(FLOW_APPLE)
+#include <pthread.h>
+#include <pthread/qos.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+constexpr std::size_t max_cpus = 64;
+
+/// How long workers wait for each other before applying their settings anyway.
+constexpr auto worker_barrier_timeout = std::chrono::seconds(1);
+
+std::uint64_t AllCPUs() noexcept
+{
+    const std::size_t count = GetCPUCount();
+    return count >= max_cpus ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+}
+
+/**
+ * @brief Removes the render thread's CPUs from a compute affinity mask.
+ * @returns The mask to pin workers to, 0 if they can run anywhere.
+ */
+std::uint64_t GetComputeAffinity(std::uint64_t requested) noexcept
+{
+    const std::uint64_t all = AllCPUs();
+    std::uint64_t mask      = (requested == 0 ? all : requested) & all & ~GetConfig().RenderThreadAffinity;
+
+    // A mask that only names render CPUs is honoured rather than leaving the workers nowhere to run.
+    if (mask == 0) mask = requested & all;
+
+    return mask == all ? 0 : mask;
+}
+} // namespace
+
+void to_json(json& j, const ExecutionLane& lane)
+{
+    const auto& colour = lane.BandColour;
+    j                  = {
+        {"name", lane.Name},
+        {"threads", lane.Threads},
+        {"priority", static_cast<int>(lane.Priority)},
+        {"colour", {colour.R, colour.G, colour.B, colour.A}},
+    };
+}
+
+void from_json(const json& j, ExecutionLane& lane)
+{
+    lane.Name     = j.at("name").get<std::string>();
+    lane.Threads  = std::max<std::size_t>(j.value("threads", std::size_t{1}), 1);
+    lane.Priority = static_cast<ThreadPriority>(std::clamp(j.value("priority", 1), 0, 2));
+
+    if (const auto colour = j.find("colour"); colour != j.end() && colour->size() == 4)
+    {
+        lane.BandColour = Colour((*colour)[0], (*colour)[1], (*colour)[2], (*colour)[3]);
+    }
+}
+
+void to_json(json& j, const ExecutorSettings& settings)
+{
+    j = {
+        {"threads", settings.Threads},
+        {"priority", static_cast<int>(settings.Priority)},
+        {"affinity", settings.AffinityMask},
+    };
+
+    if (!settings.Lanes.empty()) j["lanes"] = settings.Lanes;
+}
+
+void from_json(const json& j, ExecutorSettings& settings)
+{
+    settings.Threads      = j.value("threads", std::size_t{0});
+    settings.Priority     = static_cast<ThreadPriority>(std::clamp(j.value("priority", 1), 0, 2));
+    settings.AffinityMask = j.value("affinity", std::uint64_t{0});
+    settings.Lanes        = j.value("lanes", std::vector<ExecutionLane>{});
+}
+
+std::size_t GetCPUCount() noexcept
+{
+    return std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, max_cpus);
+}
+
+bool SetCurrentThreadScheduling(std::uint64_t affinity_mask, ThreadPriority priority) noexcept
+{
+    bool applied = true;
+
+#if defined(FLOW_WINDOWS)
+    if (affinity_mask != 0)
+    {
+        applied &= SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(affinity_mask)) != 0;
+    }
+
+    if (priority != ThreadPriority::Normal)
+    {
+        const int value = priority == ThreadPriority::Low ? THREAD_PRIORITY_BELOW_NORMAL : THREAD_PRIORITY_ABOVE_NORMAL;
+        applied &= SetThreadPriority(GetCurrentThread(), value) != 0;
+    }
+#elif defined(FLOW_APPLE)
+    // macOS has no thread affinity, only quality of service classes.
+    applied = affinity_mask == 0;
+
+    if (priority != ThreadPriority::Normal)
+    {
+        const auto qos = priority == ThreadPriority::Low ? QOS_CLASS_UTILITY : QOS_CLASS_USER_INTERACTIVE;
+        applied &= pthread_set_qos_class_self_np(qos, 0) == 0;
+    }
+#else
+    if (affinity_mask != 0)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (std::size_t cpu = 0; cpu < max_cpus; ++cpu)
+        {
+            if (affinity_mask & (std::uint64_t{1} << cpu)) CPU_SET(cpu, &cpus);
+        }
+
+        applied &= pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+    }
+
+    if (priority != ThreadPriority::Normal)
+    {
+        // Linux applies nice values per thread when given a thread ID. Raising priority needs CAP_SYS_NICE.
+        const int nice = priority == ThreadPriority::Low ? 10 : -5;
+        applied &= setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) == 0;
+    }
+#endif
+
+    return applied;
+}
+
+bool SetExecutorScheduling(flow::Env& env, std::size_t workers, std::uint64_t affinity_mask,
+                           ThreadPriority priority)
+{
+    const std::uint64_t affinity = GetComputeAffinity(affinity_mask);
+    if (affinity == 0 && priority == ThreadPriority::Normal) return true;
+
+    // The pool does not expose its threads, so one task per worker is queued and held at a barrier until every worker
+    // has picked one up. Each task then applies the settings to the thread it runs on.
+    struct Barrier
+    {
+        std::mutex Mutex;
+        std::condition_variable Condition;
+        std::size_t Arrived = 0;
+        std::atomic_bool Failed{false};
+    };
+
+    auto barrier = std::make_shared<Barrier>();
+    for (std::size_t i = 0; i < workers; ++i)
+    {
+        env.AddTask([=] {
+            {
+                std::unique_lock lock(barrier->Mutex);
+                ++barrier->Arrived;
+                barrier->Condition.notify_all();
+                barrier->Condition.wait_for(lock, worker_barrier_timeout,
+                                            [&] { return barrier->Arrived >= workers; });
+            }
+
+            if (!SetCurrentThreadScheduling(affinity, priority)) barrier->Failed = true;
+        });
+    }
+
+    env.Wait();
+
+    if (barrier->Failed)
+    {
+        SPDLOG_WARN("Could not apply the affinity or priority of every executor thread");
+    }
+
+    return !barrier->Failed;
+}
+
+std::shared_ptr<flow::Env> CreateExecutor(std::shared_ptr<flow::NodeFactory> factory, const ExecutorSettings& settings)
+{
+    flow::EnvSettings env_settings;
+    env_settings.max_threads = std::max<std::size_t>(settings.Threads, 1);
+
+    auto env = flow::Env::Create(std::move(factory), env_settings);
+    SetExecutorScheduling(*env, env_settings.max_threads, settings.AffinityMask, settings.Priority);
+
+    return env;
+}
+
+std::shared_ptr<flow::Env> CreateLaneExecutor(std::shared_ptr<flow::NodeFactory> factory,
+                                              const ExecutorSettings& settings, const ExecutionLane& lane)
+{
+    return CreateExecutor(std::move(factory), ExecutorSettings{
+                                                  .Threads      = lane.Threads,
+                                                  .Priority     = lane.Priority,
+                                                  .AffinityMask = settings.AffinityMask,
+                                              });
+}
+
+flow::SharedNode MoveNodeToEnv(flow::Graph& graph, const flow::SharedNode& node, std::shared_ptr<flow::Env> env,
+                               const std::function<void(const flow::SharedNode&)>& remove_node)
+{
+    const auto factory = env->GetFactory();
+    auto moved         = factory->CreateNode(std::string{node->GetClass()}, node->ID(), node->GetName(), env);
+    if (!moved)
+    {
+        throw std::runtime_error("Failed to move node: " + node->GetName());
+    }
+
+    moved->Restore(node->Save());
+
+    // Removing the node disconnects it, so its connections are copied out first.
+    const auto connections = graph.GetConnections().FindConnections(node->ID());
+
+    node->Stop();
+    if (remove_node)
+    {
+        remove_node(node);
+    }
+    else
+    {
+        graph.RemoveNodeByID(node->ID());
+    }
+
+    graph.AddNode(moved);
+    for (const auto& conn : connections)
+    {
+        graph.ConnectNodes(conn->StartNodeID(), conn->StartPortKey(), conn->EndNodeID(), conn->EndPortKey());
+    }
+
+    return moved;
+}
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,64 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "FrameArena.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <new>
+
+FLOW_UI_NAMESPACE_START
+
+FrameArena::FrameArena(std::size_t initial_capacity)
+    : _block{std::make_unique<std::byte[]>(initial_capacity)}, _capacity{initial_capacity}
+{
+}
+
+FrameArena::~FrameArena() { Reset(); }
+
+void FrameArena::Reset()
+{
+    for (const auto& overflow : _overflow)
+    {
+        ::operator delete(overflow.Data, std::align_val_t{overflow.Alignment});
+    }
+
+    // Grow the block to fit the whole of the last frame so the overflow is not hit again next frame.
+    if (!_overflow.empty())
+    {
+        _capacity = std::bit_ceil(_used);
+        _block    = std::make_unique<std::byte[]>(_capacity);
+        _overflow.clear();
+    }
+
+    _offset = 0;
+    _used   = 0;
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    const auto base    = reinterpret_cast<std::uintptr_t>(_block.get());
+    const auto aligned = (base + _offset + alignment - 1) & ~(alignment - 1);
+    const auto end     = aligned - base + bytes;
+
+    _used += bytes + (aligned - base - _offset);
+
+    if (end <= _capacity)
+    {
+        _offset = end;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void* data = ::operator new(bytes, std::align_val_t{alignment});
+    _overflow.push_back({data, alignment});
+
+    return data;
+}
+
+FrameArena& GetFrameArena()
+{
+    static FrameArena arena;
+    return arena;
+}
+
+FLOW_UI_NAMESPACE_END
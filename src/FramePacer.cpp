@@ -0,0 +1,70 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "FramePacer.hpp"
+
+#include "Config.hpp"
+
+#if defined(HELLOIMGUI_USE_GLFW3)
+#include <GLFW/glfw3.h>
+#elif defined(HELLOIMGUI_USE_SDL2)
+#include <SDL.h>
+#endif
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+/**
+ * @brief Interrupts the backend's wait for events so an idling render loop draws the next frame straight away.
+ */
+void PostEmptyEvent() noexcept
+{
+#if defined(HELLOIMGUI_USE_GLFW3)
+    glfwPostEmptyEvent();
+#elif defined(HELLOIMGUI_USE_SDL2)
+    SDL_Event event{};
+    event.type = SDL_USEREVENT;
+    SDL_PushEvent(&event);
+#endif
+}
+} // namespace
+
+void FramePacer::Wake() noexcept { KeepActive(GetConfig().ActiveFrameTime); }
+
+void FramePacer::KeepActive(float seconds) noexcept
+{
+    const std::int64_t until = Now() + static_cast<std::int64_t>(seconds * 1e9f);
+
+    std::int64_t current = _active_until.load();
+    while (current < until && !_active_until.compare_exchange_weak(current, until))
+    {
+    }
+
+    // Only the first wake after the loop was allowed to idle needs to interrupt it, the rest are already covered.
+    if (_may_idle.exchange(false))
+    {
+        PostEmptyEvent();
+    }
+}
+
+bool FramePacer::BeginFrame() noexcept
+{
+    // Allow idling before checking for activity, so a wake that races with this check still posts an event.
+    _may_idle.store(true);
+    if (Now() < _active_until.load())
+    {
+        _may_idle.store(false);
+        return false;
+    }
+
+    return true;
+}
+
+FramePacer& GetFramePacer()
+{
+    static FramePacer pacer;
+    return pacer;
+}
+
+FLOW_UI_NAMESPACE_END
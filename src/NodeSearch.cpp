@@ -0,0 +1,74 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "NodeSearch.hpp"
+
+#include "Profiler.hpp"
+#include "ViewFactory.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+bool ContainsIgnoreCase(std::string_view text, std::string_view lower_lookup)
+{
+    const auto it = std::search(text.begin(), text.end(), lower_lookup.begin(), lower_lookup.end(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == static_cast<unsigned char>(b);
+    });
+
+    return it != text.end() || lower_lookup.empty();
+}
+} // namespace
+
+FrameVector<const NodeSearch::Entry*> NodeSearch::Filter(const NodeFactory& factory, std::string_view lookup)
+{
+    FLOW_UI_PROFILE_SCOPE("NodeSearch::Filter");
+
+    // Classes declared by modules that are not loaded yet are listed too, loading the module when one is created.
+    const auto* view_factory     = dynamic_cast<const ViewFactory*>(&factory);
+    const auto& registered_nodes = view_factory ? view_factory->GetCatalog() : factory.GetCategories();
+
+    // Friendly names can only go stale when classes are registered or unregistered.
+    if (registered_nodes.size() != _class_count)
+    {
+        _friendly_names.clear();
+        _class_count = registered_nodes.size();
+    }
+
+    FrameString lower_lookup(lookup, &GetFrameArena());
+    std::transform(lower_lookup.begin(), lower_lookup.end(), lower_lookup.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    FrameVector<const Entry*> matches(&GetFrameArena());
+    matches.reserve(registered_nodes.size());
+
+    for (const auto& entry : registered_nodes)
+    {
+        if (lower_lookup.empty() || ContainsIgnoreCase(entry.second, lower_lookup) ||
+            ContainsIgnoreCase(GetFriendlyName(factory, entry.second), lower_lookup))
+        {
+            matches.push_back(&entry);
+        }
+    }
+
+    return matches;
+}
+
+const std::string& NodeSearch::GetFriendlyName(const NodeFactory& factory, const std::string& class_name)
+{
+    if (auto found = _friendly_names.find(std::string_view(class_name)); found != _friendly_names.end())
+    {
+        return found->second;
+    }
+
+    const auto* view_factory = dynamic_cast<const ViewFactory*>(&factory);
+    return _friendly_names
+        .emplace(class_name, view_factory ? view_factory->GetCatalogFriendlyName(class_name)
+                                          : factory.GetFriendlyName(class_name))
+        .first->second;
+}
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,114 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "Profiler.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <vector>
+
+FLOW_UI_NAMESPACE_START
+
+using json = nlohmann::json;
+
+namespace
+{
+static_assert((Profiler::Capacity & (Profiler::Capacity - 1)) == 0, "Profiler capacity must be a power of two");
+
+std::uint32_t GetThreadID() noexcept
+{
+    static std::atomic<std::uint32_t> next_id = 0;
+    thread_local const std::uint32_t id       = next_id.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+} // namespace
+
+Profiler::Profiler() : _epoch{std::chrono::steady_clock::now()}, _slots{std::make_unique<Slot[]>(Capacity)} {}
+
+void Profiler::Record(const char* name, std::int64_t start, std::int64_t end) noexcept
+{
+    const std::uint64_t index = _head.fetch_add(1, std::memory_order_relaxed);
+    auto& slot                = _slots[index & (Capacity - 1)];
+
+    // An odd sequence marks the slot as being written, readers skip it until the matching even sequence is stored.
+    slot.Sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.Name.store(name, std::memory_order_relaxed);
+    slot.Start.store(start, std::memory_order_relaxed);
+    slot.End.store(end, std::memory_order_relaxed);
+    slot.ThreadID.store(GetThreadID(), std::memory_order_relaxed);
+
+    slot.Sequence.store(index * 2 + 2, std::memory_order_release);
+}
+
+bool Profiler::Read(std::uint64_t index, ProfileEvent& event) const noexcept
+{
+    const auto& slot             = _slots[index & (Capacity - 1)];
+    const std::uint64_t sequence = slot.Sequence.load(std::memory_order_acquire);
+    if (sequence != index * 2 + 2) return false;
+
+    event.Name     = slot.Name.load(std::memory_order_relaxed);
+    event.Start    = slot.Start.load(std::memory_order_relaxed);
+    event.End      = slot.End.load(std::memory_order_relaxed);
+    event.ThreadID = slot.ThreadID.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.Sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+void Profiler::BeginFrame() noexcept
+{
+    const std::int64_t now = Now();
+    if (_frame_start != 0)
+    {
+        Record("Frame", _frame_start, now);
+        _frame_times[_frame_index++ % FrameHistory] = static_cast<float>(now - _frame_start) / 1e6f;
+    }
+
+    _frame_start = now;
+}
+
+const char* Profiler::Intern(std::string_view name)
+{
+    std::lock_guard _(_names_mutex);
+    if (auto found = std::find(_names.begin(), _names.end(), name); found != _names.end())
+    {
+        return found->c_str();
+    }
+
+    return _names.emplace_back(name).c_str();
+}
+
+std::string Profiler::ExportChromeTrace(double seconds) const
+{
+    const auto since = Now() - static_cast<std::int64_t>(seconds * 1e9);
+
+    std::vector<json> events;
+    Visit(since, [&](const ProfileEvent& event) {
+        events.push_back({
+            {"name", event.Name},
+            {"cat", "flow-ui"},
+            {"ph", "X"},
+            {"ts", static_cast<double>(event.Start) / 1e3},
+            {"dur", static_cast<double>(event.End - event.Start) / 1e3},
+            {"pid", 0},
+            {"tid", event.ThreadID},
+        });
+    });
+
+    json trace;
+    trace["traceEvents"]     = std::move(events);
+    trace["displayTimeUnit"] = "ms";
+
+    return trace.dump();
+}
+
+Profiler& GetProfiler()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,453 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "SessionRecorder.hpp"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+constexpr std::array<char, 4> recording_magic = {'F', 'L', 'R', 'C'};
+constexpr std::uint32_t recording_version     = 1;
+
+class BinaryWriter
+{
+  public:
+    explicit BinaryWriter(const std::filesystem::path& file) : _out(file, std::ios::binary)
+    {
+        if (!_out) throw std::runtime_error("Failed to open session recording for writing: " + file.string());
+    }
+
+    template<typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        _out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void WriteBytes(const std::vector<std::uint8_t>& bytes)
+    {
+        Write(static_cast<std::uint32_t>(bytes.size()));
+        _out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    void Finish()
+    {
+        _out.flush();
+        if (!_out) throw std::runtime_error("Failed to write session recording");
+    }
+
+  private:
+    std::ofstream _out;
+};
+
+class BinaryReader
+{
+  public:
+    explicit BinaryReader(const std::filesystem::path& file) : _in(file, std::ios::binary)
+    {
+        if (!_in) throw std::runtime_error("Failed to open session recording: " + file.string());
+    }
+
+    template<typename T>
+    T Read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        if (!_in.read(reinterpret_cast<char*>(&value), sizeof(T)))
+        {
+            throw std::runtime_error("Session recording is truncated");
+        }
+
+        return value;
+    }
+
+    std::vector<std::uint8_t> ReadBytes()
+    {
+        std::vector<std::uint8_t> bytes(Read<std::uint32_t>());
+        if (!_in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+        {
+            throw std::runtime_error("Session recording is truncated");
+        }
+
+        return bytes;
+    }
+
+  private:
+    std::ifstream _in;
+};
+
+RecordedInput ToRecordedInput(const ImGuiInputEvent& event)
+{
+    RecordedInput input;
+    switch (event.Type)
+    {
+    case ImGuiInputEventType_MousePos:
+        input.Type   = RecordedInput::Kind::MousePos;
+        input.Source = static_cast<std::uint8_t>(event.MousePos.MouseSource);
+        input.X      = event.MousePos.PosX;
+        input.Y      = event.MousePos.PosY;
+        break;
+    case ImGuiInputEventType_MouseWheel:
+        input.Type   = RecordedInput::Kind::MouseWheel;
+        input.Source = static_cast<std::uint8_t>(event.MouseWheel.MouseSource);
+        input.X      = event.MouseWheel.WheelX;
+        input.Y      = event.MouseWheel.WheelY;
+        break;
+    case ImGuiInputEventType_MouseButton:
+        input.Type   = RecordedInput::Kind::MouseButton;
+        input.Source = static_cast<std::uint8_t>(event.MouseButton.MouseSource);
+        input.Code   = static_cast<std::uint32_t>(event.MouseButton.Button);
+        input.Down   = event.MouseButton.Down;
+        break;
+    case ImGuiInputEventType_MouseViewport:
+        input.Type = RecordedInput::Kind::MouseViewport;
+        input.Code = event.MouseViewport.HoveredViewportID;
+        break;
+    case ImGuiInputEventType_Key:
+        input.Type = RecordedInput::Kind::Key;
+        input.Code = static_cast<std::uint32_t>(event.Key.Key);
+        input.Down = event.Key.Down;
+        input.X    = event.Key.AnalogValue;
+        break;
+    case ImGuiInputEventType_Text:
+        input.Type = RecordedInput::Kind::Text;
+        input.Code = event.Text.Char;
+        break;
+    case ImGuiInputEventType_Focus:
+        input.Type = RecordedInput::Kind::Focus;
+        input.Down = event.AppFocused.Focused;
+        break;
+    default:
+        break;
+    }
+
+    return input;
+}
+
+ImGuiInputEvent ToImGuiInputEvent(const RecordedInput& input)
+{
+    ImGuiInputEvent event{};
+    switch (input.Type)
+    {
+    case RecordedInput::Kind::MousePos:
+        event.Type                 = ImGuiInputEventType_MousePos;
+        event.Source               = ImGuiInputSource_Mouse;
+        event.MousePos.MouseSource = static_cast<ImGuiMouseSource>(input.Source);
+        event.MousePos.PosX        = input.X;
+        event.MousePos.PosY        = input.Y;
+        break;
+    case RecordedInput::Kind::MouseWheel:
+        event.Type                   = ImGuiInputEventType_MouseWheel;
+        event.Source                 = ImGuiInputSource_Mouse;
+        event.MouseWheel.MouseSource = static_cast<ImGuiMouseSource>(input.Source);
+        event.MouseWheel.WheelX      = input.X;
+        event.MouseWheel.WheelY      = input.Y;
+        break;
+    case RecordedInput::Kind::MouseButton:
+        event.Type                    = ImGuiInputEventType_MouseButton;
+        event.Source                  = ImGuiInputSource_Mouse;
+        event.MouseButton.MouseSource = static_cast<ImGuiMouseSource>(input.Source);
+        event.MouseButton.Button      = static_cast<int>(input.Code);
+        event.MouseButton.Down        = input.Down;
+        break;
+    case RecordedInput::Kind::MouseViewport:
+        event.Type                            = ImGuiInputEventType_MouseViewport;
+        event.Source                          = ImGuiInputSource_Mouse;
+        event.MouseViewport.HoveredViewportID = input.Code;
+        break;
+    case RecordedInput::Kind::Key:
+        event.Type            = ImGuiInputEventType_Key;
+        event.Source          = ImGuiInputSource_Keyboard;
+        event.Key.Key         = static_cast<ImGuiKey>(input.Code);
+        event.Key.Down        = input.Down;
+        event.Key.AnalogValue = input.X;
+        break;
+    case RecordedInput::Kind::Text:
+        event.Type      = ImGuiInputEventType_Text;
+        event.Source    = ImGuiInputSource_Keyboard;
+        event.Text.Char = input.Code;
+        break;
+    case RecordedInput::Kind::Focus:
+        event.Type               = ImGuiInputEventType_Focus;
+        event.AppFocused.Focused = input.Down;
+        break;
+    }
+
+    return event;
+}
+
+template<typename T>
+T& GetHookOwner(ImGuiContextHook* hook)
+{
+    return *static_cast<T*>(hook->UserData);
+}
+} // namespace
+
+void SessionRecording::Save(const std::filesystem::path& file) const
+{
+    BinaryWriter writer(file);
+    writer.Write(recording_magic);
+    writer.Write(recording_version);
+    writer.Write(DisplayWidth);
+    writer.Write(DisplayHeight);
+    writer.WriteBytes(json::to_msgpack(json{{"name", FlowName}, {"flow", Flow}}));
+
+    writer.Write(static_cast<std::uint32_t>(Frames.size()));
+    for (const auto& frame : Frames)
+    {
+        writer.Write(frame.DeltaTime);
+        writer.Write(static_cast<std::uint32_t>(frame.Events.size()));
+
+        // Only the fields used by each kind of event are written to keep recordings small.
+        for (const auto& input : frame.Events)
+        {
+            writer.Write(input.Type);
+            switch (input.Type)
+            {
+            case RecordedInput::Kind::MousePos:
+            case RecordedInput::Kind::MouseWheel:
+                writer.Write(input.Source);
+                writer.Write(input.X);
+                writer.Write(input.Y);
+                break;
+            case RecordedInput::Kind::MouseButton:
+                writer.Write(input.Source);
+                writer.Write(static_cast<std::uint8_t>(input.Code));
+                writer.Write(input.Down);
+                break;
+            case RecordedInput::Kind::MouseViewport:
+            case RecordedInput::Kind::Text:
+                writer.Write(input.Code);
+                break;
+            case RecordedInput::Kind::Key:
+                writer.Write(static_cast<std::uint16_t>(input.Code));
+                writer.Write(input.Down);
+                writer.Write(input.X);
+                break;
+            case RecordedInput::Kind::Focus:
+                writer.Write(input.Down);
+                break;
+            }
+        }
+    }
+
+    writer.Finish();
+}
+
+SessionRecording SessionRecording::Load(const std::filesystem::path& file)
+{
+    BinaryReader reader(file);
+    if (reader.Read<std::array<char, 4>>() != recording_magic)
+    {
+        throw std::runtime_error("Not a session recording: " + file.string());
+    }
+
+    if (const auto version = reader.Read<std::uint32_t>(); version != recording_version)
+    {
+        throw std::runtime_error("Unsupported session recording version: " + std::to_string(version));
+    }
+
+    SessionRecording recording;
+    recording.DisplayWidth  = reader.Read<float>();
+    recording.DisplayHeight = reader.Read<float>();
+
+    const json flow_json = json::from_msgpack(reader.ReadBytes());
+    recording.FlowName   = flow_json["name"].get<std::string>();
+    recording.Flow       = flow_json["flow"];
+
+    recording.Frames.resize(reader.Read<std::uint32_t>());
+    for (auto& frame : recording.Frames)
+    {
+        frame.DeltaTime = reader.Read<float>();
+        frame.Events.resize(reader.Read<std::uint32_t>());
+
+        for (auto& input : frame.Events)
+        {
+            input.Type = reader.Read<RecordedInput::Kind>();
+            switch (input.Type)
+            {
+            case RecordedInput::Kind::MousePos:
+            case RecordedInput::Kind::MouseWheel:
+                input.Source = reader.Read<std::uint8_t>();
+                input.X      = reader.Read<float>();
+                input.Y      = reader.Read<float>();
+                break;
+            case RecordedInput::Kind::MouseButton:
+                input.Source = reader.Read<std::uint8_t>();
+                input.Code   = reader.Read<std::uint8_t>();
+                input.Down   = reader.Read<bool>();
+                break;
+            case RecordedInput::Kind::MouseViewport:
+            case RecordedInput::Kind::Text:
+                input.Code = reader.Read<std::uint32_t>();
+                break;
+            case RecordedInput::Kind::Key:
+                input.Code = reader.Read<std::uint16_t>();
+                input.Down = reader.Read<bool>();
+                input.X    = reader.Read<float>();
+                break;
+            case RecordedInput::Kind::Focus:
+                input.Down = reader.Read<bool>();
+                break;
+            default:
+                throw std::runtime_error("Session recording contains an unknown input event");
+            }
+        }
+    }
+
+    return recording;
+}
+
+SessionRecorder::SessionRecorder(ImGuiContext* ctx, std::string flow_name, json flow) : _ctx{ctx}
+{
+    const auto& io           = ctx->IO;
+    _recording.FlowName      = std::move(flow_name);
+    _recording.Flow          = std::move(flow);
+    _recording.DisplayWidth  = io.DisplaySize.x;
+    _recording.DisplayHeight = io.DisplaySize.y;
+
+    // Events already in the queue belong to a frame that has started, so recording starts after them.
+    _last_event_id = ctx->InputEventsNextEventId - 1;
+
+    ImGuiContextHook hook;
+    hook.Type     = ImGuiContextHookType_NewFramePre;
+    hook.Callback = [](ImGuiContext*, ImGuiContextHook* hook) { GetHookOwner<SessionRecorder>(hook).RecordFrame(); };
+    hook.UserData = this;
+
+    _hook_id = ImGui::AddContextHook(ctx, &hook);
+}
+
+SessionRecorder::~SessionRecorder() { ImGui::RemoveContextHook(_ctx, _hook_id); }
+
+void SessionRecorder::RecordFrame()
+{
+    auto& frame     = _recording.Frames.emplace_back();
+    frame.DeltaTime = _ctx->IO.DeltaTime;
+
+    // ImGui can keep events queued over several frames, so only events that were not seen before are recorded.
+    for (const auto& event : _ctx->InputEventsQueue)
+    {
+        if (event.EventId <= _last_event_id) continue;
+
+        frame.Events.push_back(ToRecordedInput(event));
+        _last_event_id = event.EventId;
+    }
+}
+
+void to_json(json& j, const ReplayStats& stats)
+{
+    j = {
+        {"frames", stats.Frames}, {"mean_ms", stats.Mean}, {"p50_ms", stats.P50},
+        {"p95_ms", stats.P95},    {"p99_ms", stats.P99},   {"max_ms", stats.Max},
+    };
+}
+
+SessionReplayer::SessionReplayer(ImGuiContext* ctx, SessionRecording recording, ReplayPace pace)
+    : _ctx{ctx}, _recording{std::move(recording)}, _pace{pace}
+{
+    _frame_times.reserve(_recording.Frames.size());
+
+    ImGuiContextHook hook;
+    hook.Type     = ImGuiContextHookType_NewFramePre;
+    hook.Callback = [](ImGuiContext*, ImGuiContextHook* hook) { GetHookOwner<SessionReplayer>(hook).ReplayFrame(); };
+    hook.UserData = this;
+
+    _hook_id = ImGui::AddContextHook(ctx, &hook);
+}
+
+SessionReplayer::~SessionReplayer() { ImGui::RemoveContextHook(_ctx, _hook_id); }
+
+ReplayStats SessionReplayer::GetStats() const
+{
+    ReplayStats stats;
+    stats.Frames = _frame_times.size();
+    if (_frame_times.empty()) return stats;
+
+    std::vector<double> sorted = _frame_times;
+    std::sort(sorted.begin(), sorted.end());
+
+    const auto percentile = [&](double p) {
+        return sorted[static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1))];
+    };
+
+    double total = 0.0;
+    for (double frame_time : sorted)
+    {
+        total += frame_time;
+    }
+
+    stats.Mean = total / static_cast<double>(sorted.size());
+    stats.P50  = percentile(0.5);
+    stats.P95  = percentile(0.95);
+    stats.P99  = percentile(0.99);
+    stats.Max  = sorted.back();
+
+    return stats;
+}
+
+void SessionReplayer::ReplayFrame()
+{
+    const auto now = Clock::now();
+    if (_next_frame > 0 && _next_frame <= _recording.Frames.size())
+    {
+        _frame_times.push_back(std::chrono::duration<double, std::milli>(now - _frame_start).count());
+    }
+
+    if (_next_frame >= _recording.Frames.size())
+    {
+        _next_frame = _recording.Frames.size() + 1;
+        return;
+    }
+
+    const auto& frame = _recording.Frames[_next_frame++];
+
+    if (_pace == ReplayPace::Recorded && _next_frame > 1)
+    {
+        std::this_thread::sleep_until(_frame_start + std::chrono::duration<float>(frame.DeltaTime));
+    }
+
+    _frame_start = Clock::now();
+
+    _ctx->IO.DeltaTime = frame.DeltaTime;
+
+    // Live input is dropped, but replayed events that ImGui trickled over from an earlier frame are kept, as the
+    // recorder only saw them once.
+    auto& queue = _ctx->InputEventsQueue;
+    std::vector<std::uint32_t> replayed_ids;
+    int kept = 0;
+    for (const auto& event : queue)
+    {
+        if (std::find(_replayed_event_ids.begin(), _replayed_event_ids.end(), event.EventId) ==
+            _replayed_event_ids.end())
+        {
+            continue;
+        }
+
+        replayed_ids.push_back(event.EventId);
+        queue[kept++] = event;
+    }
+
+    queue.resize(kept);
+    _replayed_event_ids = std::move(replayed_ids);
+
+    for (const auto& input : frame.Events)
+    {
+        ImGuiInputEvent event = ToImGuiInputEvent(input);
+        event.EventId         = _ctx->InputEventsNextEventId++;
+        queue.push_back(event);
+        _replayed_event_ids.push_back(event.EventId);
+    }
+}
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,97 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "TypeRegistry.hpp"
+
+#include <algorithm>
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+PortIconType GetIconType(std::string_view type)
+{
+    if (type.find("vector") != std::string_view::npos) return PortIconType::Grid;
+
+    if (type.find("*") != std::string_view::npos || type.find("unique_ptr") != std::string_view::npos ||
+        type.find("&") != std::string_view::npos)
+    {
+        return GetStyle().PortShapes.Ref;
+    }
+
+    return GetStyle().PortShapes.Default;
+}
+} // namespace
+
+TypeId TypeRegistry::Intern(std::string_view type)
+{
+    if (auto found = _ids.find(type); found != _ids.end())
+    {
+        return found->second;
+    }
+
+    const auto id = static_cast<TypeId>(_types.size());
+    auto& info    = _types.emplace_back(TypeInfo{.ID = id, .Name = std::string{type}});
+    Resolve(info);
+
+    _ids.emplace(info.Name, id);
+
+    return id;
+}
+
+void TypeRegistry::SetInputConstructor(std::string_view type, InputFieldConstructor_t constructor)
+{
+    _types[Intern(type)].InputConstructor = std::move(constructor);
+}
+
+void TypeRegistry::Refresh()
+{
+    for (auto& info : _types)
+    {
+        Resolve(info);
+    }
+}
+
+void TypeRegistry::SetDataSize(std::string_view type, DataSizeFunction_t data_size)
+{
+    _types[Intern(type)].DataSize = std::move(data_size);
+}
+
+void TypeRegistry::SetConversionCheck(std::function<bool(std::string_view, std::string_view)> is_convertible)
+{
+    _is_convertible = std::move(is_convertible);
+    InvalidateCompatibility();
+}
+
+TypeCompatibility TypeRegistry::GetCompatibility(TypeId from, TypeId to) const
+{
+    if (from == to) return TypeCompatibility::Exact;
+
+    if (_compatibility_stride < _types.size())
+    {
+        _compatibility_stride = _types.size();
+        _compatibility.assign(_compatibility_stride * _compatibility_stride, TypeCompatibility::Unresolved);
+    }
+
+    auto& compatibility = _compatibility[from * _compatibility_stride + to];
+    if (compatibility == TypeCompatibility::Unresolved)
+    {
+        const bool convertible = _is_convertible && _is_convertible(_types[from].Name, _types[to].Name);
+        compatibility          = convertible ? TypeCompatibility::Convertible : TypeCompatibility::Incompatible;
+    }
+
+    return compatibility;
+}
+
+void TypeRegistry::InvalidateCompatibility() noexcept
+{
+    std::fill(_compatibility.begin(), _compatibility.end(), TypeCompatibility::Unresolved);
+}
+
+void TypeRegistry::Resolve(TypeInfo& info) const
+{
+    info.PortColour = GetStyle().GetTypeColour(info.Name);
+    info.Icon       = GetIconType(info.Name);
+}
+
+FLOW_UI_NAMESPACE_END
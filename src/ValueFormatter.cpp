@@ -0,0 +1,243 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "ValueFormatter.hpp"
+
+#include "Config.hpp"
+#include "FramePacer.hpp"
+#include "ViewFactory.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+constexpr std::size_t max_row_width = 256;
+
+bool IsContinuationByte(char c) { return (static_cast<unsigned char>(c) & 0xC0) == 0x80; }
+
+std::size_t FloorToCharBoundary(std::string_view text, std::size_t pos)
+{
+    while (pos > 0 && pos < text.size() && IsContinuationByte(text[pos]))
+    {
+        --pos;
+    }
+
+    return pos;
+}
+
+bool IsSameData(const std::weak_ptr<NodeData>& a, const SharedNodeData& b)
+{
+    return !a.owner_before(b) && !b.owner_before(a);
+}
+} // namespace
+
+FormattedValue MakeFormattedValue(std::string text)
+{
+    const auto& config = GetConfig();
+
+    FormattedValue value;
+    value.Text = std::move(text);
+
+    const std::string_view view = value.Text;
+
+    value.LineCount   = view.empty() ? 0 : static_cast<std::size_t>(std::count(view.begin(), view.end(), '\n')) + 1;
+    value.PreviewSize = FloorToCharBoundary(view, std::min(view.size(), config.ValuePreviewMaxBytes));
+
+    std::size_t lines    = 0;
+    std::size_t line_end = view.find('\n');
+    while (line_end != std::string_view::npos && ++lines < config.ValuePreviewMaxLines)
+    {
+        line_end = view.find('\n', line_end + 1);
+    }
+
+    if (line_end != std::string_view::npos)
+    {
+        value.PreviewSize = std::min(value.PreviewSize, line_end);
+    }
+
+    if (!value.IsTruncated()) return value;
+
+    std::size_t row_start = 0;
+    while (row_start < view.size())
+    {
+        value.RowOffsets.push_back(row_start);
+
+        const std::size_t newline = view.find('\n', row_start);
+        const std::size_t row_end = std::min(newline == std::string_view::npos ? view.size() : newline + 1,
+                                             FloorToCharBoundary(view, row_start + max_row_width));
+
+        row_start = row_end > row_start ? row_end : row_start + max_row_width;
+    }
+
+    return value;
+}
+
+ValueFormatter::ValueFormatter() : _worker([this](std::stop_token stop_token) { Run(std::move(stop_token)); }) {}
+
+ValueFormatter::~ValueFormatter() { Stop(); }
+
+void ValueFormatter::Acquire(const ValuePortKey& port)
+{
+    std::lock_guard _(_mutex);
+    ++_entries[port].References;
+}
+
+void ValueFormatter::Release(const ValuePortKey& port)
+{
+    std::lock_guard _(_mutex);
+    auto found = _entries.find(port);
+    if (found == _entries.end() || --found->second.References > 0) return;
+
+    _entries.erase(found);
+    _pending.erase(port);
+}
+
+void ValueFormatter::Evict(const flow::UUID& node)
+{
+    std::lock_guard _(_mutex);
+    for (auto& [key, entry] : _entries)
+    {
+        if (key.Node != node) continue;
+
+        entry.Data.reset();
+        entry.Result.reset();
+        _pending.erase(key);
+    }
+}
+
+void ValueFormatter::Request(const ValuePortKey& port, const SharedNodeData& data, std::string_view type)
+{
+    static const auto none_value = std::make_shared<const FormattedValue>(MakeFormattedValue("None"));
+
+    if (!_worker.joinable()) return;
+
+    {
+        std::lock_guard _(_mutex);
+
+        auto found = _entries.find(port);
+        if (found == _entries.end()) return;
+
+        auto& entry = found->second;
+        if (!data)
+        {
+            entry.Data.reset();
+            entry.Result = none_value;
+            _pending.erase(port);
+            return;
+        }
+
+        if (IsSameData(entry.Data, data)) return;
+
+        entry.Data = data;
+        _pending.erase(port);
+    }
+
+    // Typed formatters write bounded output, so they run straight away without holding the lock.
+    if (auto result = FormatTyped(data, type))
+    {
+        std::lock_guard _(_mutex);
+        if (auto found = _entries.find(port); found != _entries.end())
+        {
+            found->second.Result = std::move(result);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard _(_mutex);
+        if (!_entries.contains(port)) return;
+
+        _pending.emplace(port, data);
+        _queue.push_back(port);
+    }
+
+    _condition.notify_one();
+}
+
+std::shared_ptr<const FormattedValue> ValueFormatter::FormatTyped(const SharedNodeData& data, std::string_view type)
+{
+    auto factory = _factory.lock();
+    if (!factory) return nullptr;
+
+    // Request can be called from any thread, so each keeps its own storage instead of sharing one outside the lock.
+    thread_local std::string storage;
+    storage.resize(GetConfig().ValuePreviewMaxBytes);
+    FormatBuffer buffer(storage.data(), storage.size());
+    if (!factory->FormatValue(data, type, buffer)) return nullptr;
+
+    std::string text{buffer.View()};
+    if (buffer.IsTruncated()) text += "...";
+
+    return std::make_shared<const FormattedValue>(MakeFormattedValue(std::move(text)));
+}
+
+std::shared_ptr<const FormattedValue> ValueFormatter::Get(const ValuePortKey& port) const
+{
+    std::lock_guard _(_mutex);
+    if (auto it = _entries.find(port); it != _entries.end())
+    {
+        return it->second.Result;
+    }
+
+    return nullptr;
+}
+
+void ValueFormatter::Stop()
+{
+    if (!_worker.joinable()) return;
+
+    _worker.request_stop();
+    _worker.join();
+}
+
+void ValueFormatter::Run(std::stop_token stop_token)
+{
+    while (!stop_token.stop_requested())
+    {
+        std::unique_lock lock(_mutex);
+        if (!_condition.wait(lock, stop_token, [this] { return !_queue.empty(); })) return;
+
+        const ValuePortKey port = _queue.front();
+        _queue.pop_front();
+
+        auto pending = _pending.find(port);
+        if (pending == _pending.end()) continue;
+
+        SharedNodeData data = std::move(pending->second);
+        _pending.erase(pending);
+        lock.unlock();
+
+        std::shared_ptr<const FormattedValue> result;
+        try
+        {
+            result = std::make_shared<const FormattedValue>(MakeFormattedValue(data->ToString()));
+        }
+        catch (const std::exception& e)
+        {
+            SPDLOG_ERROR("Caught exception while formatting value: {0}", e.what());
+            result = std::make_shared<const FormattedValue>(MakeFormattedValue("<error>"));
+        }
+
+        lock.lock();
+        if (auto it = _entries.find(port); it != _entries.end() && IsSameData(it->second.Data, data))
+        {
+            it->second.Result = std::move(result);
+            lock.unlock();
+
+            GetFramePacer().Wake();
+        }
+    }
+}
+
+ValueFormatter& GetValueFormatter()
+{
+    static ValueFormatter formatter;
+    return formatter;
+}
+
+FLOW_UI_NAMESPACE_END
@@ -3,12 +3,32 @@
 
 #include "ViewFactory.hpp"
 
+#include <algorithm>
+#include <any>
+#include <mutex>
+#include <shared_mutex>
+
 #ifdef FLOW_WINDOWS
 #undef GetClassName
 #endif
 
 FLOW_UI_NAMESPACE_START
 
+ViewFactory::ViewFactory()
+{
+    _types.SetConversionCheck([this](std::string_view from, std::string_view to) {
+        constexpr std::string_view any_type = flow::TypeName_v<std::any>;
+        return from == any_type || to == any_type || IsConvertible(from, to);
+    });
+
+    // Modules register their conversions along with their node classes, which can make checked types convertible.
+    OnNodeClassRegistered.Bind("InvalidateTypeCompatibility",
+                               [this](std::string_view) { _types.InvalidateCompatibility(); });
+    OnNodeClassUnregistered.Bind("InvalidateTypeCompatibility",
+                                 [this](std::string_view) { _types.InvalidateCompatibility(); });
+    OnNodeClassUnregistered.Bind("InvalidateCatalog", [this](std::string_view) { _catalog_dirty = true; });
+}
+
 std::shared_ptr<NodeView> ViewFactory::CreateNodeView(flow::SharedNode node)
 {
     auto found = _constructors.find(std::string{node->GetClass()});
@@ -20,4 +40,106 @@ std::shared_ptr<NodeView> ViewFactory::CreateNodeView(flow::SharedNode node)
     return std::shared_ptr<NodeView>(reinterpret_cast<NodeView*>(found->second(std::move(node))));
 }
 
+std::unordered_map<std::string, InputFieldConstructor_t> ViewFactory::GetRegisteredInputTypes() const
+{
+    std::unordered_map<std::string, InputFieldConstructor_t> input_types;
+    for (TypeId id = 0; id < _types.Size(); ++id)
+    {
+        const auto& info = _types.Get(id);
+        if (info.InputConstructor) input_types.emplace(info.Name, info.InputConstructor);
+    }
+
+    return input_types;
+}
+
+bool ViewFactory::FormatValue(const SharedNodeData& data, std::string_view type, FormatBuffer& buffer) const
+{
+    if (!data) return false;
+
+    if (auto found = _formatters.find(type); found != _formatters.end() && found->second(data, buffer))
+    {
+        return true;
+    }
+
+    {
+        std::shared_lock _(_unformatted_mutex);
+        if (_unformatted_types.contains(type)) return false;
+    }
+
+    if (std::any_of(_formatters.begin(), _formatters.end(),
+                    [&](const auto& entry) { return entry.second(data, buffer); }))
+    {
+        return true;
+    }
+
+    // Ports accepting any type hold values of different types, so only the other ports' types can be remembered.
+    if (type != flow::TypeName_v<std::any>)
+    {
+        std::unique_lock _(_unformatted_mutex);
+        _unformatted_types.emplace(type);
+    }
+
+    return false;
+}
+
+void ViewFactory::DeclareNodeClass(const std::string& class_name, std::string category, std::string friendly_name)
+{
+    _declared_classes.insert_or_assign(class_name, DeclaredNodeClass{std::move(category), std::move(friendly_name)});
+    _catalog_dirty = true;
+}
+
+void ViewFactory::RemoveDeclaredNodeClass(const std::string& class_name)
+{
+    if (_declared_classes.erase(class_name) != 0) _catalog_dirty = true;
+}
+
+bool ViewFactory::RequireNodeClass(const std::string& class_name)
+{
+    GetCatalog();
+    if (_registered_classes.contains(class_name)) return true;
+
+    OnNodeClassRequired(class_name);
+
+    GetCatalog();
+    return _registered_classes.contains(class_name);
+}
+
+const flow::CategoryMap& ViewFactory::GetCatalog() const
+{
+    // Registering a class changes the size of the category map, unregistering one or declaring classes marks it dirty.
+    const auto& registered = GetCategories();
+    if (!_catalog_dirty && registered.size() == _catalog_registered_count) return _catalog;
+
+    _catalog = registered;
+    _registered_classes.clear();
+    for (const auto& [_, class_name] : registered)
+    {
+        _registered_classes.insert(class_name);
+    }
+
+    for (const auto& [class_name, declared] : _declared_classes)
+    {
+        if (!_registered_classes.contains(class_name)) _catalog.emplace(declared.Category, class_name);
+    }
+
+    _catalog_registered_count = registered.size();
+    _catalog_dirty            = false;
+
+    return _catalog;
+}
+
+std::string ViewFactory::GetCatalogFriendlyName(const std::string& class_name) const
+{
+    GetCatalog();
+    if (!_registered_classes.contains(class_name))
+    {
+        if (auto declared = _declared_classes.find(class_name); declared != _declared_classes.end())
+        {
+            return declared->second.FriendlyName.empty() ? class_name : declared->second.FriendlyName;
+        }
+    }
+
+    return GetFriendlyName(class_name);
+}
+
 FLOW_UI_NAMESPACE_END
@@ -11,6 +11,7 @@ FLOW_UI_SUBNAMESPACE_START(utility)
 void NodeBuilder::Begin(ed::NodeId id)
 {
     _has_header = false;
+    _band_color = 0;
     _header_min = _header_max = ImVec2();
 
     ed::PushStyleVar(ed::StyleVar_NodePadding, ImVec4(8, 4, 8, 8));
@@ -39,6 +40,12 @@ void NodeBuilder::End()
 
             drawList->AddRectFilled(_header_min - ImVec2(7, 3), _header_max + ImVec2(7, 0), _header_color,
                                     ed::GetStyle().NodeRounding - 1, ImDrawFlags_RoundCornersTop);
+
+            if (_band_color != 0)
+            {
+                drawList->AddRectFilled(_header_min - ImVec2(7, 3), ImVec2(_header_max.x + 7, _header_min.y + 1),
+                                        _band_color, ed::GetStyle().NodeRounding - 1, ImDrawFlags_RoundCornersTop);
+            }
         }
     }
 
@@ -59,6 +66,8 @@ void NodeBuilder::Header(const ImVec4& color)
 
 void NodeBuilder::EndHeader() { SetStage(Stage::Content); }
 
+void NodeBuilder::Band(const ImVec4& color) { _band_color = ImColor(color); }
+
 void NodeBuilder::Input(ed::PinId id)
 {
     if (_current_stage == Stage::Begin)
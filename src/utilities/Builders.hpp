@@ -22,6 +22,8 @@ class NodeBuilder
     void Header(const ImVec4& color = ImVec4(1, 1, 1, 1));
     void EndHeader();
 
+    void Band(const ImVec4& color);
+
     void Input(ed::PinId id);
     void EndInput();
 
@@ -57,6 +59,7 @@ class NodeBuilder
     bool _has_header            = false;
     Stage _current_stage        = Stage::Invalid;
     ImU32 _header_color         = ImColor(1, 1, 1, 1);
+    ImU32 _band_color           = 0;
     ImVec2 _node_min;
     ImVec2 _node_max;
     ImVec2 _header_min;
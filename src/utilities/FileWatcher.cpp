@@ -0,0 +1,129 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "FileWatcher.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <cstring>
+
+#if !defined(FLOW_WINDOWS) && !defined(FLOW_APPLE)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FLOW_UI_SUBNAMESPACE_START(utility)
+
+namespace
+{
+std::filesystem::file_time_type GetModifiedTime(const std::filesystem::path& file)
+{
+    std::error_code ec;
+    const auto time = std::filesystem::last_write_time(file, ec);
+    return ec ? std::filesystem::file_time_type::min() : time;
+}
+} // namespace
+
+FileWatcher::FileWatcher(std::chrono::duration<float> debounce) : _debounce(debounce)
+{
+#if !defined(FLOW_WINDOWS) && !defined(FLOW_APPLE)
+    _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotify < 0)
+    {
+        SPDLOG_WARN("Could not create an inotify instance, watched files are polled instead");
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#if !defined(FLOW_WINDOWS) && !defined(FLOW_APPLE)
+    if (_inotify >= 0) close(_inotify);
+#endif
+}
+
+void FileWatcher::Watch(const std::filesystem::path& file)
+{
+    const auto [watched, added] = _files.try_emplace(file.string(), WatchedFile{.ModifiedTime = GetModifiedTime(file)});
+    if (!added || _inotify < 0) return;
+
+#if !defined(FLOW_WINDOWS) && !defined(FLOW_APPLE)
+    // Build tools usually replace files rather than writing to them, so the directory is watched instead of the file.
+    const auto directory = file.parent_path();
+    const int watch      = inotify_add_watch(_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (watch >= 0)
+    {
+        _directories[watch]    = directory;
+        watched->second.Polled = false;
+    }
+    else
+    {
+        SPDLOG_WARN("Could not watch directory '{0}', '{1}' is polled instead: {2}", directory.string(),
+                    file.filename().string(), std::strerror(errno));
+    }
+#endif
+}
+
+std::vector<std::filesystem::path> FileWatcher::Poll()
+{
+    const auto now = Clock::now();
+    ReadEvents(now);
+    CompareModifiedTimes(now);
+
+    std::vector<std::filesystem::path> changed;
+    for (auto& [file, watched] : _files)
+    {
+        // A file is written in several steps, so it is only reported once it has been left alone for a while.
+        if (!watched.ChangedAt || now - *watched.ChangedAt < _debounce) continue;
+
+        watched.ChangedAt.reset();
+
+        std::error_code ec;
+        if (std::filesystem::exists(file, ec)) changed.emplace_back(file);
+    }
+
+    return changed;
+}
+
+void FileWatcher::ReadEvents([[maybe_unused]] Clock::time_point now)
+{
+#if !defined(FLOW_WINDOWS) && !defined(FLOW_APPLE)
+    if (_inotify < 0) return;
+
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length = 0;
+    while ((length = read(_inotify, buffer, sizeof(buffer))) > 0)
+    {
+        for (const char* next = buffer; next < buffer + length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(next);
+            next += sizeof(inotify_event) + event->len;
+
+            const auto directory = _directories.find(event->wd);
+            if (directory == _directories.end() || event->len == 0) continue;
+
+            if (auto watched = _files.find((directory->second / event->name).string()); watched != _files.end())
+            {
+                watched->second.ChangedAt = now;
+            }
+        }
+    }
+#endif
+}
+
+void FileWatcher::CompareModifiedTimes(Clock::time_point now)
+{
+    for (auto& [file, watched] : _files)
+    {
+        if (!watched.Polled) continue;
+
+        const auto modified_time = GetModifiedTime(file);
+        if (modified_time == watched.ModifiedTime) continue;
+
+        watched.ModifiedTime = modified_time;
+        watched.ChangedAt    = now;
+    }
+}
+
+FLOW_UI_SUBNAMESPACE_END
@@ -0,0 +1,73 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "flow/ui/Core.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+FLOW_UI_SUBNAMESPACE_START(utility)
+
+/**
+ * @brief Reports changes to a set of files without blocking.
+ *
+ * Linux is notified of changes with inotify, other platforms and files whose directory cannot be watched compare
+ * modification times on every poll.
+ */
+class FileWatcher
+{
+    using Clock = std::chrono::steady_clock;
+
+  public:
+    /**
+     * @brief Creates a watcher.
+     * @param debounce How long a changed file has to be left untouched before the change is reported.
+     */
+    explicit FileWatcher(std::chrono::duration<float> debounce);
+
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&)            = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Starts watching a file.
+     * @param file The file, which does not have to exist yet.
+     */
+    void Watch(const std::filesystem::path& file);
+
+    /**
+     * @brief Gets the files that changed since the last poll and have settled since.
+     * @returns The changed files that exist.
+     */
+    std::vector<std::filesystem::path> Poll();
+
+  private:
+    void ReadEvents(Clock::time_point now);
+    void CompareModifiedTimes(Clock::time_point now);
+
+  private:
+    struct WatchedFile
+    {
+        std::filesystem::file_time_type ModifiedTime;
+        std::optional<Clock::time_point> ChangedAt;
+
+        /// Whether the modification time is compared on every poll, because changes to the file are not notified.
+        bool Polled = true;
+    };
+
+    std::chrono::duration<float> _debounce;
+    std::unordered_map<std::string, WatchedFile> _files;
+
+    /// The inotify instance and its watched directories, Linux only.
+    int _inotify = -1;
+    std::unordered_map<int, std::filesystem::path> _directories;
+};
+
+FLOW_UI_SUBNAMESPACE_END
@@ -0,0 +1,219 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "Process.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(FLOW_WINDOWS)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(FLOW_APPLE)
+#include <crt_externs.h>
+#else
+extern char** environ;
+#endif
+#endif
+
+FLOW_UI_SUBNAMESPACE_START(utility)
+
+namespace
+{
+#if !defined(FLOW_WINDOWS)
+char** GetEnvironment() noexcept
+{
+#if defined(FLOW_APPLE)
+    return *_NSGetEnviron();
+#else
+    return environ;
+#endif
+}
+#endif
+} // namespace
+
+Process::Process(const std::vector<std::string>& args)
+{
+    if (args.empty()) throw std::invalid_argument("No program to run was given");
+
+#if defined(FLOW_WINDOWS)
+    SECURITY_ATTRIBUTES security{};
+    security.nLength        = sizeof(security);
+    security.bInheritHandle = TRUE;
+
+    HANDLE read_pipe  = nullptr;
+    HANDLE write_pipe = nullptr;
+    if (!CreatePipe(&read_pipe, &write_pipe, &security, 0))
+    {
+        throw std::runtime_error("Failed to create the output pipe of '" + args.front() + "'");
+    }
+
+    SetHandleInformation(read_pipe, HANDLE_FLAG_INHERIT, 0);
+
+    std::string command_line;
+    for (const auto& arg : args)
+    {
+        if (!command_line.empty()) command_line += ' ';
+        command_line += '"' + arg + '"';
+    }
+
+    STARTUPINFOA startup{};
+    startup.cb         = sizeof(startup);
+    startup.dwFlags    = STARTF_USESTDHANDLES;
+    startup.hStdInput  = GetStdHandle(STD_INPUT_HANDLE);
+    startup.hStdOutput = write_pipe;
+    startup.hStdError  = write_pipe;
+
+    // The process is added to a job before it runs, so cancelling also stops the compilers it starts.
+    PROCESS_INFORMATION info{};
+    const BOOL created = CreateProcessA(nullptr, command_line.data(), nullptr, nullptr, TRUE,
+                                        CREATE_NO_WINDOW | CREATE_SUSPENDED, nullptr, nullptr, &startup, &info);
+    CloseHandle(write_pipe);
+
+    if (!created)
+    {
+        CloseHandle(read_pipe);
+        throw std::runtime_error(fmt::format("Failed to start '{}': error {}", args.front(), GetLastError()));
+    }
+
+    _job = CreateJobObjectA(nullptr, nullptr);
+    if (_job) AssignProcessToJobObject(_job, info.hProcess);
+
+    ResumeThread(info.hThread);
+    CloseHandle(info.hThread);
+
+    _process = info.hProcess;
+    _handle  = read_pipe;
+#else
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        throw std::runtime_error(fmt::format("Failed to create the output pipe of '{}': {}", args.front(),
+                                             std::strerror(errno)));
+    }
+
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDERR_FILENO);
+
+    // The process leads its own group, so cancelling also stops the compilers it starts.
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+    posix_spawnattr_setpgroup(&attributes, 0);
+
+    std::vector<char*> argv;
+    for (const auto& arg : args)
+    {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid       = -1;
+    const int error = posix_spawnp(&pid, argv.front(), &actions, &attributes, argv.data(), GetEnvironment());
+
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+
+    if (error != 0)
+    {
+        close(fds[0]);
+        throw std::runtime_error(fmt::format("Failed to start '{}': {}", args.front(), std::strerror(error)));
+    }
+
+    _pid  = pid;
+    _pipe = fds[0];
+#endif
+
+    _reader = std::thread([this] { Read(); });
+}
+
+Process::~Process()
+{
+    Cancel();
+    if (_reader.joinable()) _reader.join();
+
+#if defined(FLOW_WINDOWS)
+    if (_handle) CloseHandle(_handle);
+    if (_job) CloseHandle(_job);
+    if (_process) CloseHandle(_process);
+#else
+    if (_pipe >= 0) close(_pipe);
+#endif
+}
+
+void Process::Cancel() noexcept
+{
+    if (!_running) return;
+
+#if defined(FLOW_WINDOWS)
+    if (_job)
+    {
+        TerminateJobObject(_job, 1);
+    }
+    else
+    {
+        TerminateProcess(_process, 1);
+    }
+#else
+    kill(-_pid, SIGTERM);
+#endif
+}
+
+std::string Process::TakeOutput()
+{
+    std::lock_guard lock(_mutex);
+    return std::exchange(_output, {});
+}
+
+void Process::Read()
+{
+    char buffer[4096];
+    while (true)
+    {
+#if defined(FLOW_WINDOWS)
+        DWORD count = 0;
+        if (!ReadFile(_handle, buffer, sizeof(buffer), &count, nullptr) || count == 0) break;
+#else
+        const ssize_t count = read(_pipe, buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR) continue;
+        if (count <= 0) break;
+#endif
+
+        std::lock_guard lock(_mutex);
+        _output.append(buffer, static_cast<std::size_t>(count));
+    }
+
+#if defined(FLOW_WINDOWS)
+    WaitForSingleObject(_process, INFINITE);
+
+    DWORD exit_code = 0;
+    GetExitCodeProcess(_process, &exit_code);
+    _exit_code = static_cast<int>(exit_code);
+#else
+    int status = 0;
+    while (waitpid(_pid, &status, 0) < 0 && errno == EINTR)
+    {
+    }
+
+    _exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+
+    _running = false;
+}
+
+FLOW_UI_SUBNAMESPACE_END
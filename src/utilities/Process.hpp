@@ -0,0 +1,82 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "flow/ui/Core.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+FLOW_UI_SUBNAMESPACE_START(utility)
+
+/**
+ * @brief A child process whose standard output and error are read in the background.
+ */
+class Process
+{
+  public:
+    /**
+     * @brief Starts a process.
+     *
+     * @param args The program, which is looked up on the PATH, followed by its arguments.
+     *
+     * @throws std::runtime_error if the process could not be started.
+     */
+    explicit Process(const std::vector<std::string>& args);
+
+    /**
+     * @brief Stops the process if it is still running.
+     */
+    ~Process();
+
+    Process(const Process&)            = delete;
+    Process& operator=(const Process&) = delete;
+
+    /**
+     * @brief Stops the process along with the processes it started.
+     */
+    void Cancel() noexcept;
+
+    /**
+     * @brief Gets whether the process is still running.
+     * @returns true if the process has not exited yet, false otherwise.
+     */
+    bool IsRunning() const noexcept { return _running.load(); }
+
+    /**
+     * @brief Gets the exit code of the process once it is no longer running.
+     * @returns The exit code, -1 if the process was stopped by a signal.
+     */
+    int GetExitCode() const noexcept { return _exit_code.load(); }
+
+    /**
+     * @brief Takes the output the process wrote since the last call, standard output and error interleaved.
+     * @returns The new output.
+     */
+    std::string TakeOutput();
+
+  private:
+    void Read();
+
+  private:
+    std::thread _reader;
+    std::mutex _mutex;
+    std::string _output;
+    std::atomic_bool _running{true};
+    std::atomic_int _exit_code{-1};
+
+    /// Handles of the process, its job object and the read end of its output pipe on Windows.
+    void* _process = nullptr;
+    void* _job     = nullptr;
+    void* _handle  = nullptr;
+
+    /// ID of the process, which leads its own process group, and the read end of its output pipe elsewhere.
+    int _pid  = -1;
+    int _pipe = -1;
+};
+
+FLOW_UI_SUBNAMESPACE_END
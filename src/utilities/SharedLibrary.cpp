@@ -0,0 +1,36 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "SharedLibrary.hpp"
+
+#if defined(FLOW_WINDOWS)
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+FLOW_UI_SUBNAMESPACE_START(utility)
+
+SharedLibrary::SharedLibrary(const std::filesystem::path& file) noexcept
+{
+    if (file.empty()) return;
+
+#if defined(FLOW_WINDOWS)
+    _handle = static_cast<void*>(LoadLibraryW(file.c_str()));
+#else
+    _handle = dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+}
+
+SharedLibrary::~SharedLibrary()
+{
+    if (!_handle) return;
+
+#if defined(FLOW_WINDOWS)
+    FreeLibrary(static_cast<HMODULE>(_handle));
+#else
+    dlclose(_handle);
+#endif
+}
+
+FLOW_UI_SUBNAMESPACE_END
@@ -0,0 +1,42 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "flow/ui/Core.hpp"
+
+#include <filesystem>
+
+FLOW_UI_SUBNAMESPACE_START(utility)
+
+/**
+ * @brief Holds a reference to a shared library, keeping it mapped into the process while it is alive.
+ *
+ * Opening a library that is already loaded only takes another reference. This lets the expensive parts of loading and
+ * unloading, mapping the file and running its static initialisers and destructors, happen on a background thread.
+ */
+class SharedLibrary
+{
+  public:
+    /**
+     * @brief Opens a shared library.
+     * @param file The library file. Nothing is opened if it is empty or cannot be loaded.
+     */
+    explicit SharedLibrary(const std::filesystem::path& file) noexcept;
+
+    ~SharedLibrary();
+
+    SharedLibrary(const SharedLibrary&)            = delete;
+    SharedLibrary& operator=(const SharedLibrary&) = delete;
+
+    /**
+     * @brief Gets whether the library was opened.
+     * @returns true if the library is open, false otherwise.
+     */
+    bool IsOpen() const noexcept { return _handle != nullptr; }
+
+  private:
+    void* _handle = nullptr;
+};
+
+FLOW_UI_SUBNAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include "Core.hpp"
 #include "FileExplorer.hpp"
+#include "FrameArena.hpp"
 #include "Style.hpp"
 
 #include <flow/core/Concepts.hpp>
@@ -33,7 +34,7 @@ static inline bool InputInteger(ImGuiDataType type, std::string_view name, T& va
 {
     ImGui::PushItemWidth(50.0f);
 
-    ImGui::InputScalar(("##" + std::string{name}).c_str(), type, &value, 0, 0, "%d", flags);
+    ImGui::InputScalar(FrameFormat("##{}", name), type, &value, 0, 0, "%d", flags);
 
     ImGui::PopItemWidth();
 
@@ -46,7 +47,7 @@ static inline bool InputChrono(std::string_view name, D& value, ImGuiInputTextFl
     ImGui::PushItemWidth(100.0f);
 
     const D step{1};
-    ImGui::InputScalar(("##" + std::string{name}).c_str(), ImGuiDataType_S64, &value, &step, 0, "%d", flags);
+    ImGui::InputScalar(FrameFormat("##{}", name), ImGuiDataType_S64, &value, &step, 0, "%d", flags);
 
     ImGui::PopItemWidth();
 
@@ -59,7 +60,7 @@ static inline bool InputField(std::string_view name, T& value, ImGuiInputTextFla
 template<>
 inline bool InputField<bool>(std::string_view name, bool& value, ImGuiInputTextFlags)
 {
-    return ImGui::Checkbox(("##" + std::string{name}).c_str(), &value);
+    return ImGui::Checkbox(FrameFormat("##{}", name), &value);
 }
 
 template<>
@@ -115,7 +116,7 @@ inline bool InputField<float>(std::string_view name, float& value, ImGuiInputTex
 {
     ImGui::PushItemWidth(50.0f);
 
-    ImGui::InputFloat(("##" + std::string{name}).c_str(), &value, 0, 0, "%.3f", flags);
+    ImGui::InputFloat(FrameFormat("##{}", name), &value, 0, 0, "%.3f", flags);
 
     ImGui::PopItemWidth();
 
@@ -127,7 +128,7 @@ inline bool InputField<double>(std::string_view name, double& value, ImGuiInputT
 {
     ImGui::PushItemWidth(50.0f);
 
-    ImGui::InputDouble(("##" + std::string{name}).c_str(), &value, 0, 0, "%.3f", flags);
+    ImGui::InputDouble(FrameFormat("##{}", name), &value, 0, 0, "%.3f", flags);
 
     ImGui::PopItemWidth();
 
@@ -139,7 +140,7 @@ inline bool InputField<std::string>(std::string_view name, std::string& value, I
 {
     ImGui::PushItemWidth(150.0f);
 
-    ImGui::InputText(("##" + std::string{name}).c_str(), &value, flags);
+    ImGui::InputText(FrameFormat("##{}", name), &value, flags);
 
     ImGui::PopItemWidth();
 
@@ -2,25 +2,43 @@
 // All rights reserved.
 
 #include "ConnectionView.hpp"
+
+#include "Config.hpp"
+#include "FramePacer.hpp"
 #include "utilities/Conversions.hpp"
 
 #include <imgui_node_editor.h>
+#include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 FLOW_UI_NAMESPACE_START
 
 namespace ed = ax::NodeEditor;
 
+namespace
+{
+constexpr double rate_smoothing_time = 1.0;
+constexpr float base_thickness       = 2.f;
+constexpr float max_extra_thickness  = 4.f;
+} // namespace
+
 ConnectionView::ConnectionView(const flow::UUID& id, std::uint64_t start_port_id, std::uint64_t end_port_id,
-                               const Colour& colour)
-    : ID(std::hash<flow::UUID>{}(id)), StartPortID(start_port_id), EndPortID(end_port_id), _colour(colour)
+                               const TypeInfo& type)
+    : ID(std::hash<flow::UUID>{}(id)), StartPortID(start_port_id), EndPortID(end_port_id), _type(&type),
+      _counters{std::make_unique<Counters>()}
 {
 }
 
 void ConnectionView::Draw()
 {
-    if (!ed::Link(ID, StartPortID, EndPortID, utility::to_ImColor(_colour), 2.0f))
+    UpdateRates();
+
+    // Thickness follows the order of magnitude of the event rate so busy links stand out.
+    const float thickness = base_thickness + std::min(max_extra_thickness, std::log10(1.f + _event_rate));
+    if (!ed::Link(ID, StartPortID, EndPortID, utility::to_ImColor(GetColour()), thickness))
     {
         throw std::runtime_error("Failed to set link for pins");
     }
@@ -30,11 +48,69 @@ void ConnectionView::Draw()
         // TODO(trigaux): Reroute nodes
     }
 
-    if (IsFlowing())
+    // Busy links only restart the flow animation once per interval instead of on every event.
+    const std::uint64_t events = _counters->Events.load(std::memory_order_relaxed);
+    const double now           = ImGui::GetTime();
+    if (events != _flowed_events && now - _flow_time >= GetConfig().LinkFlowInterval)
     {
         ed::Flow(ID);
-        SetFlowing(false);
+        _flowed_events = events;
+        _flow_time     = now;
+
+        // The flow animation needs full rate frames until its markers reach the end of the link.
+        GetFramePacer().KeepActive(ed::GetStyle().FlowDuration);
+    }
+}
+
+void ConnectionView::RecordEvent(const SharedNodeData& data) noexcept
+{
+    _counters->Events.fetch_add(1, std::memory_order_relaxed);
+
+    if (!data || !_type->DataSize) return;
+
+    try
+    {
+        _counters->Bytes.fetch_add(_type->DataSize(data), std::memory_order_relaxed);
+    }
+    catch (const std::exception& e)
+    {
+        SPDLOG_ERROR("Failed to measure the size of data on link: {0}", e.what());
     }
+    catch (...)
+    {
+        SPDLOG_ERROR("Caught unknown exception while measuring the size of data on link");
+    }
+}
+
+void ConnectionView::DrawStats() const
+{
+    const auto events = _counters->Events.load(std::memory_order_relaxed);
+
+    ImGui::Text("%.1f events/s (%llu total)", _event_rate, static_cast<unsigned long long>(events));
+    if (_type->DataSize)
+    {
+        const auto bytes = _counters->Bytes.load(std::memory_order_relaxed);
+        ImGui::Text("%.1f KiB/s (%.1f KiB total)", _byte_rate / 1024.f, static_cast<double>(bytes) / 1024.0);
+    }
+}
+
+void ConnectionView::UpdateRates()
+{
+    const double now = ImGui::GetTime();
+    const double dt  = now - _sample_time;
+    if (dt <= 0.0) return;
+
+    const std::uint64_t events = _counters->Events.load(std::memory_order_relaxed);
+    const std::uint64_t bytes  = _counters->Bytes.load(std::memory_order_relaxed);
+
+    // Exponential moving average, weighted by the frame time so the smoothing does not depend on the frame rate.
+    const auto alpha = static_cast<float>(1.0 - std::exp(-dt / rate_smoothing_time));
+    _event_rate += alpha * (static_cast<float>(static_cast<double>(events - _sampled_events) / dt) - _event_rate);
+    _byte_rate += alpha * (static_cast<float>(static_cast<double>(bytes - _sampled_bytes) / dt) - _byte_rate);
+
+    _sampled_events = events;
+    _sampled_bytes  = bytes;
+    _sample_time    = now;
 }
 
 FLOW_UI_NAMESPACE_END
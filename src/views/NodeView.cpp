@@ -5,6 +5,7 @@
 
 #include "Config.hpp"
 #include "ConnectionView.hpp"
+#include "FramePacer.hpp"
 #include "PortView.hpp"
 #include "ViewFactory.hpp"
 #include "utilities/Builders.hpp"
@@ -19,6 +20,11 @@
 #include <imgui_stdlib.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
 #include <map>
 #include <vector>
 
@@ -40,6 +46,24 @@ inline ImRect ImRect_Expanded(const ImRect& rect, float x, float y)
     result.Max.y += y;
     return result;
 }
+
+Colour LerpColour(const Colour& a, const Colour& b, float t)
+{
+    const auto lerp = [t](std::uint8_t x, std::uint8_t y) {
+        return static_cast<std::uint8_t>(static_cast<float>(x) + (static_cast<float>(y) - static_cast<float>(x)) * t);
+    };
+
+    return Colour(lerp(a.R, b.R), lerp(a.G, b.G), lerp(a.B, b.B), lerp(a.A, b.A));
+}
+
+Colour HeatColour(float heat)
+{
+    constexpr Colour cool{40, 140, 70};
+    constexpr Colour warm{200, 160, 30};
+    constexpr Colour hot{200, 40, 30};
+
+    return heat < 0.5f ? LerpColour(cool, warm, heat * 2.f) : LerpColour(warm, hot, heat * 2.f - 1.f);
+}
 } // namespace
 
 GraphItemView::~GraphItemView()
@@ -57,10 +81,19 @@ void GraphItemView::ShowConnectables(const std::shared_ptr<PortView>&) {}
 
 NodeView::NodeView(const flow::SharedNode& node, Colour header_colour)
 try : GraphItemView(std::hash<flow::UUID>{}(node->ID())), NodeID(node->ID()), Name(node->GetName()),
-    HeaderColour(header_colour), _builder{std::make_shared<utility::NodeBuilder>()}
+    HeaderColour(header_colour), _builder{std::make_shared<utility::NodeBuilder>()},
+      _compute_stats{std::make_shared<NodeComputeStats>()}
 {
     node->OnCompute.Bind("ClearError", [&]() { _received_error = false; });
-    node->OnError.Bind("SetError", [&](const std::exception&) { _received_error = true; });
+    node->OnError.Bind("SetError", [&](const std::exception&) {
+        _received_error = true;
+        GetFramePacer().Wake();
+    });
+
+    // There is no event for the end of a compute, so the first output or error marks it instead.
+    node->OnCompute.Bind("ComputeStats", [stats = _compute_stats] { stats->BeginCompute(); });
+    node->OnSetOutput.Bind("ComputeStats", [stats = _compute_stats](const auto&, const auto&) { stats->EndCompute(); });
+    node->OnError.Bind("ComputeStats", [stats = _compute_stats](const std::exception&) { stats->EndCompute(); });
 
     auto on_input = [this, env = node->GetEnv(), n = node](const auto& key, auto data) {
         env->AddTask([key, c = std::move(n), d = std::move(data)] {
@@ -110,7 +143,8 @@ try
 
     _builder->Begin(_id);
 
-    _builder->Header(utility::to_ImColor(HeaderColour));
+    _builder->Header(utility::to_ImColor(GetHeatmapColour()));
+    if (LaneColour) _builder->Band(utility::to_ImColor(*LaneColour));
     ImGui::Spring(0);
 
     if (GetConfig().NodeHeaderFont)
@@ -174,6 +208,78 @@ void NodeView::ShowConnectables(const std::shared_ptr<PortView>& new_link_pin)
     }
 }
 
+void NodeView::DrawComputeStats()
+{
+    UpdateCallRate();
+
+    const auto buckets = _compute_stats->Latency.Snapshot();
+    const auto p50     = std::chrono::duration<double, std::milli>(LatencyHistogram::Percentile(buckets, 0.5));
+    const auto p99     = std::chrono::duration<double, std::milli>(LatencyHistogram::Percentile(buckets, 0.99));
+
+    ImGui::TextUnformatted(Name.c_str());
+    ImGui::Separator();
+    ImGui::Text("Computes: %llu (%.1f/s)",
+                static_cast<unsigned long long>(_compute_stats->Calls.load(std::memory_order_relaxed)), _call_rate);
+
+    const auto last = std::find_if(buckets.rbegin(), buckets.rend(), [](auto count) { return count > 0; });
+    if (last == buckets.rend())
+    {
+        ImGui::TextDisabled("No outputs recorded yet");
+        return;
+    }
+
+    ImGui::Text("Latency: p50 < %.3f ms, p99 < %.3f ms", p50.count(), p99.count());
+
+    std::array<float, LatencyHistogram::BucketCount> values{};
+    std::transform(buckets.begin(), buckets.end(), values.begin(),
+                   [](auto bucket_count) { return static_cast<float>(bucket_count); });
+
+    const int count = static_cast<int>(std::distance(last, buckets.rend()));
+    ImGui::PlotHistogram("##Latency", values.data(), count, 0, nullptr, 0.f, FLT_MAX, ImVec2(240.f, 60.f));
+    ImGui::TextDisabled("Bucket i holds latencies below 2^i us");
+}
+
+Colour NodeView::GetHeatmapColour()
+{
+    const auto& config = GetConfig();
+
+    float ratio = 0.f;
+    switch (config.NodeHeatmap)
+    {
+    case NodeHeatmapMode::None:
+        return HeaderColour;
+    case NodeHeatmapMode::LatencyP50:
+    case NodeHeatmapMode::LatencyP99: {
+        const double percentile = config.NodeHeatmap == NodeHeatmapMode::LatencyP50 ? 0.5 : 0.99;
+        const auto latency      = LatencyHistogram::Percentile(_compute_stats->Latency.Snapshot(), percentile);
+
+        ratio = std::chrono::duration<float, std::milli>(latency).count() / config.NodeHeatmapMaxLatency;
+        break;
+    }
+    case NodeHeatmapMode::CallRate:
+        UpdateCallRate();
+        ratio = _call_rate / config.NodeHeatmapMaxCallRate;
+        break;
+    }
+
+    // Latencies and rates span orders of magnitude, so the heat is scaled logarithmically.
+    const float heat = std::log1p(9.f * std::clamp(ratio, 0.f, 1.f)) / std::log(10.f);
+    return LerpColour(HeaderColour, HeatColour(heat), 0.75f);
+}
+
+void NodeView::UpdateCallRate()
+{
+    constexpr double sample_interval = 0.5;
+
+    const double now = ImGui::GetTime();
+    if (now - _rate_time < sample_interval) return;
+
+    const std::uint64_t calls = _compute_stats->Calls.load(std::memory_order_relaxed);
+    _call_rate                = static_cast<float>(static_cast<double>(calls - _rate_calls) / (now - _rate_time));
+    _rate_calls               = calls;
+    _rate_time                = now;
+}
+
 SimpleNodeView::SimpleNodeView(const flow::SharedNode& node) : NodeView(node)
 {
     for (const auto& input : Inputs)
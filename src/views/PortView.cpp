@@ -26,24 +26,11 @@ namespace ed = ax::NodeEditor;
 
 namespace
 {
-PortIconType GetIconType(std::string_view type)
-{
-    if (type.find("vector") != std::string_view::npos) return PortIconType::Grid;
-
-    if (type.find("*") != std::string_view::npos || type.find("unique_ptr") != std::string_view::npos ||
-        type.find("&") != std::string_view::npos)
-    {
-        return GetStyle().PortShapes.Ref;
-    }
-
-    return GetStyle().PortShapes.Default;
-}
-
 void DrawPinIcon(const PortView& pin, bool connected, int alpha)
 {
     auto colour = pin.GetColour();
     colour.A    = static_cast<std::uint8_t>(alpha);
-    widgets::Icon(ImVec2(24.f, 24.f), GetIconType(pin.Type()), connected, utility::to_ImColor(colour),
+    widgets::Icon(ImVec2(24.f, 24.f), pin.GetTypeInfo().Icon, connected, utility::to_ImColor(colour),
                   ImColor(32, 32, 32, alpha));
 }
 } // namespace
@@ -53,10 +40,12 @@ PortView::PortView(const std::uint64_t& node_id, std::shared_ptr<Port> port_data
     : ID(std::hash<flow::UUID>{}({})), NodeViewID(node_id), Name(port_data->GetVarName()), _port{std::move(port_data)},
       _show_label{_port->GetKey() != flow::IndexableName::None && show_label}, OnSetInput{input_function}
 {
-    const auto& input_ctors = factory->GetRegisteredInputTypes();
-    if (input_ctors.contains(std::string{Type()}))
+    _types = &factory->GetTypeRegistry();
+    _type  = &_types->Get(_types->Intern(Type()));
+
+    if (_type->InputConstructor)
     {
-        _input_field = input_ctors.at(std::string{Type()})(Name, _port->GetData());
+        _input_field = _type->InputConstructor(Name, _port->GetData());
     }
 }
 
@@ -103,8 +92,6 @@ void PortView::Draw()
     }
 }
 
-constexpr std::string_view AnyType = flow::TypeName_v<std::any>;
-
 bool PortView::CanLink(const std::shared_ptr<PortView>& other) const noexcept
 {
     if (IsConnected() && Kind == PortType::Input || !other || ID == other->ID || Kind == other->Kind ||
@@ -113,7 +100,10 @@ bool PortView::CanLink(const std::shared_ptr<PortView>& other) const noexcept
         return false;
     }
 
-    return Type() == other->Type() || Type() == AnyType || other->Type() == AnyType;
+    const TypeId output = Kind == PortType::Output ? GetTypeID() : other->GetTypeID();
+    const TypeId input  = Kind == PortType::Output ? other->GetTypeID() : GetTypeID();
+
+    return _types->GetCompatibility(output, input) != TypeCompatibility::Incompatible;
 }
 
 void PortView::DrawInput()
@@ -138,7 +128,8 @@ void PortView::DrawLabel()
     if (!_show_label) return;
 
     ImGui::AlignTextToFramePadding();
-    ImGui::TextUnformatted(std::string{Name.substr(0, Name.find("##"))}.c_str());
+    const std::string_view label = std::string_view(Name).substr(0, Name.find("##"));
+    ImGui::TextUnformatted(label.data(), label.data() + label.size());
 }
 
 void PortView::DrawIcon(float alpha) { ::flow::ui::DrawPinIcon(*this, IsConnected(), static_cast<int>(alpha * 255)); }
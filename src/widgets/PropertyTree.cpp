@@ -1,22 +1,78 @@
 #include "PropertyTree.hpp"
-#include "Table.hpp"
 
 #include <imgui.h>
 
+#include <algorithm>
+
 FLOW_UI_SUBNAMESPACE_START(widgets)
 
+PropertyTree::Category::Category(const std::string& name, std::size_t columns)
+    : View(name + "##table", columns), Columns(std::max<std::size_t>(columns, 1))
+{
+    View.SetRowProvider(0, [this](std::size_t row) { DrawRow(row); });
+}
+
+void PropertyTree::Category::Layout()
+{
+    Rows.clear();
+    for (auto& [name, property] : Properties)
+    {
+        Rows.push_back({&name, &property, HeaderRow});
+        if (!property.Open) continue;
+
+        for (std::size_t i = 0; i < property.Widgets.size(); i += Columns)
+        {
+            Rows.push_back({&name, &property, i});
+        }
+    }
+
+    View.SetRowCount(Rows.size());
+    NeedsLayout = false;
+}
+
+void PropertyTree::Category::DrawRow(std::size_t row)
+{
+    const auto& [name, property, first_widget] = Rows[row];
+    if (first_widget == HeaderRow)
+    {
+        ImGui::TableNextColumn();
+        ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, ImGui::GetColorU32(ImGuiCol_Header));
+        ImGui::AlignTextToFramePadding();
+
+        // The open state is kept with the property, as it decides which rows exist. The new rows are laid out before
+        // the next frame, since the clipper is still stepping through the current ones.
+        ImGui::SetNextItemOpen(property->Open);
+        if (ImGui::TreeNodeEx(name->c_str(), ImGuiTreeNodeFlags_NoTreePushOnOpen) != property->Open)
+        {
+            property->Open = !property->Open;
+            NeedsLayout    = true;
+        }
+        return;
+    }
+
+    const auto last_widget = std::min(first_widget + Columns, property->Widgets.size());
+    for (auto i = first_widget; i < last_widget; ++i)
+    {
+        ImGui::TableNextColumn();
+        ImGui::AlignTextToFramePadding();
+        if (const auto& widget = property->Widgets[i]) (*widget)();
+    }
+}
+
 PropertyTree::PropertyTree(const std::string& name, std::size_t columns) : _name(name), _columns(columns) {}
 
 void PropertyTree::AddProperty(const std::string& name, std::shared_ptr<Widget> widget,
                                const std::string& category_name)
 {
-    _properties[category_name][name] = {std::move(widget)};
+    AddProperty(name, std::vector<std::shared_ptr<Widget>>{std::move(widget)}, category_name);
 }
 
 void PropertyTree::AddProperty(const std::string& name, const std::vector<std::shared_ptr<Widget>>& widgets,
                                const std::string& category_name)
 {
-    _properties[category_name][name] = widgets;
+    auto& category = _categories.try_emplace(category_name, category_name, _columns).first->second;
+    category.Properties.insert_or_assign(name, Property{widgets});
+    category.NeedsLayout = true;
 }
 
 void PropertyTree::operator()() noexcept
@@ -45,7 +101,7 @@ void PropertyTree::operator()() noexcept
     ImGui::PopFont();
     ImGui::PopStyleVar();
 
-    for (const auto& [category_name, properties] : _properties)
+    for (auto& [category_name, category] : _categories)
     {
         ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(15.f, 10.f));
         if (!ImGui::TreeNodeEx(category_name.c_str(), ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed |
@@ -55,29 +111,13 @@ void PropertyTree::operator()() noexcept
             continue;
         }
 
-        for (const auto& [name, widgets] : properties)
-        {
-            ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(15.f, 5.f));
-            if (!ImGui::TreeNodeEx(name.c_str(), ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed |
-                                                     ImGuiTreeNodeFlags_FramePadding))
-            {
-                ImGui::PopStyleVar();
-                continue;
-            }
-
-            auto property_table =
-                Table(category_name + "##table", _columns, static_cast<std::size_t>(ImGui::GetItemRectSize().x + 1.f));
-            for (const auto& widget : widgets)
-            {
-                property_table.AddEntry(widget);
-            }
-
-            ImGui::SetCursorPos(ImGui::GetCursorPos() - ImVec2(5.f, 1.f));
-            property_table();
-
-            ImGui::TreePop();
-            ImGui::PopStyleVar();
-        }
+        if (category.NeedsLayout) category.Layout();
+
+        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(15.f, 5.f));
+        category.View.SetOuterSize(static_cast<std::size_t>(ImGui::GetItemRectSize().x + 1.f));
+        ImGui::SetCursorPos(ImGui::GetCursorPos() - ImVec2(5.f, 1.f));
+        category.View();
+        ImGui::PopStyleVar();
 
         ImGui::TreePop();
         ImGui::PopStyleVar();
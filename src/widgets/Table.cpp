@@ -2,32 +2,82 @@
 
 #include <imgui.h>
 
+#include <cassert>
+
 FLOW_UI_SUBNAMESPACE_START(widgets)
 
 Table::Table(const std::string& name, std::size_t columns, std::size_t outer_width, std::size_t outer_height)
-    : _name(name), _columns(columns), _outer_width(outer_width), _outer_height(outer_height)
+    : _name(name), _columns(columns), _outer_width(outer_width), _outer_height(outer_height),
+      _column_sizing(columns, ColumnSizing::Auto)
 {
 }
 
 void Table::operator()() noexcept
 {
-    ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(15.f, 5.f));
-    ImGui::BeginTable(_name.c_str(), static_cast<int>(_columns), ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg,
-                      ImVec2{static_cast<float>(_outer_width), static_cast<float>(_outer_height)});
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg;
+    flags |= _borders == Borders::Outer ? ImGuiTableFlags_BordersOuter : ImGuiTableFlags_Borders;
+    if (_row_provider && _outer_height > 0) flags |= ImGuiTableFlags_ScrollY;
 
-    for (const auto& widget : _widgets)
+    ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(_cell_padding_x, _cell_padding_y));
+    if (!ImGui::BeginTable(_name.c_str(), static_cast<int>(_columns), flags,
+                           ImVec2{static_cast<float>(_outer_width), static_cast<float>(_outer_height)}))
     {
-        if (!widget) continue;
+        ImGui::PopStyleVar();
+        return;
+    }
 
-        ImGui::TableNextColumn();
-        ImGui::AlignTextToFramePadding();
-        (*widget)();
+    for (const auto& sizing : _column_sizing)
+    {
+        switch (sizing)
+        {
+        case ColumnSizing::Auto:
+            ImGui::TableSetupColumn("");
+            break;
+        case ColumnSizing::Fixed:
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed);
+            break;
+        case ColumnSizing::Stretch:
+            ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthStretch);
+            break;
+        }
+    }
+
+    if (_row_provider)
+    {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(_row_count));
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                ImGui::TableNextRow();
+                ImGui::PushID(row);
+                _row_provider(static_cast<std::size_t>(row));
+                ImGui::PopID();
+            }
+        }
+        clipper.End();
+    }
+    else
+    {
+        for (const auto& widget : _widgets)
+        {
+            if (!widget) continue;
+
+            ImGui::TableNextColumn();
+            ImGui::AlignTextToFramePadding();
+            (*widget)();
+        }
     }
 
     ImGui::EndTable();
     ImGui::PopStyleVar();
 }
 
-void Table::AddEntry(std::shared_ptr<Widget> widget) { _widgets.emplace_back(std::move(widget)); }
+void Table::AddEntry(std::shared_ptr<Widget> widget)
+{
+    assert(!_row_provider);
+    _widgets.emplace_back(std::move(widget));
+}
 
 FLOW_UI_SUBNAMESPACE_END
@@ -1,6 +1,8 @@
 #include "Text.hpp"
 #include "utilities/Conversions.hpp"
 
+#include <utility>
+
 FLOW_UI_SUBNAMESPACE_START(widgets)
 
 Text::Text(const std::string& text, const Colour& colour, const Alignment& align)
@@ -53,6 +55,12 @@ void Text::operator()() noexcept
     ImGui::PopStyleColor();
 }
 
+Text& Text::SetText(std::string new_text) noexcept
+{
+    _text = std::move(new_text);
+    return *this;
+}
+
 Text& Text::SetColour(const Colour& new_colour) noexcept
 {
     _colour = new_colour;
@@ -0,0 +1,48 @@
+#include "TextViewer.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+
+FLOW_UI_SUBNAMESPACE_START(widgets)
+
+TextViewer::TextViewer(const std::string& name, std::size_t visible_rows) : _name(name), _visible_rows(visible_rows)
+{
+}
+
+void TextViewer::operator()() noexcept
+{
+    if (!_value) return;
+
+    const std::string_view text = _value->Text;
+    const auto& rows            = _value->RowOffsets;
+    if (rows.empty())
+    {
+        ImGui::TextUnformatted(text.data(), text.data() + text.size());
+        return;
+    }
+
+    const float height =
+        ImGui::GetTextLineHeightWithSpacing() * static_cast<float>(std::min(rows.size(), _visible_rows) + 1);
+
+    if (ImGui::BeginChild(_name.c_str(), ImVec2(0.f, height), true, ImGuiWindowFlags_HorizontalScrollbar))
+    {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rows.size()));
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                const std::size_t start = rows[row];
+                std::size_t end         = static_cast<std::size_t>(row + 1) < rows.size() ? rows[row + 1] : text.size();
+                if (end > start && text[end - 1] == '\n') --end;
+
+                ImGui::TextUnformatted(text.data() + start, text.data() + end);
+            }
+        }
+        clipper.End();
+    }
+    ImGui::EndChild();
+}
+
+FLOW_UI_SUBNAMESPACE_END
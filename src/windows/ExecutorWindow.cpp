@@ -0,0 +1,230 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "ExecutorWindow.hpp"
+
+#include "Config.hpp"
+#include "GraphWindow.hpp"
+#include "utilities/Conversions.hpp"
+
+#include <imgui.h>
+#include <imgui_stdlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <optional>
+#include <set>
+#include <string>
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+constexpr int max_threads          = 256;
+constexpr std::size_t cpus_per_row = 8;
+constexpr float input_width        = 120.f;
+
+constexpr const char* priority_names[] = {"Low", "Normal", "High"};
+} // namespace
+
+ExecutorWindow::ExecutorWindow() : Window("Executor") {}
+
+void ExecutorWindow::SetCurrentGraph(const std::shared_ptr<GraphWindow>& graph_window)
+{
+    if (_graph_window.lock() == graph_window) return;
+
+    _graph_window = graph_window;
+    _settings     = graph_window ? graph_window->GetExecutorSettings() : ExecutorSettings{};
+}
+
+void ExecutorWindow::Draw()
+{
+    auto graph_window = _graph_window.lock();
+    if (!graph_window)
+    {
+        return Window::Draw();
+    }
+
+    ImGui::Text("Flow: %s", graph_window->GetName().c_str());
+    ImGui::Separator();
+
+    int threads = static_cast<int>(_settings.Threads);
+    ImGui::SetNextItemWidth(input_width);
+    if (ImGui::InputInt("Threads", &threads))
+    {
+        _settings.Threads = static_cast<std::size_t>(std::clamp(threads, 0, max_threads));
+    }
+    ImGui::SameLine();
+    ImGui::TextDisabled(_settings.Threads == 0 ? "(shared executor)" : "(own executor)");
+
+    ImGui::BeginDisabled(_settings.Threads == 0);
+
+    int priority = static_cast<int>(_settings.Priority);
+    ImGui::SetNextItemWidth(input_width);
+    if (ImGui::Combo("Priority", &priority, priority_names, IM_ARRAYSIZE(priority_names)))
+    {
+        _settings.Priority = static_cast<ThreadPriority>(priority);
+    }
+
+    DrawAffinity();
+
+    ImGui::EndDisabled();
+
+    ImGui::Separator();
+
+    DrawLanes(*graph_window);
+
+    ImGui::Separator();
+
+    ImGui::BeginDisabled(_settings == graph_window->GetExecutorSettings() || !LanesValid());
+    if (ImGui::Button("Apply"))
+    {
+        OnApply(graph_window, _settings);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Revert"))
+    {
+        _settings = graph_window->GetExecutorSettings();
+    }
+    ImGui::EndDisabled();
+}
+
+void ExecutorWindow::DrawAffinity()
+{
+    ImGui::TextUnformatted("CPU Affinity");
+
+    const std::uint64_t reserved = GetConfig().RenderThreadAffinity;
+    const std::size_t cpus       = GetCPUCount();
+
+    for (std::size_t cpu = 0; cpu < cpus; ++cpu)
+    {
+        const std::uint64_t bit = std::uint64_t{1} << cpu;
+        bool enabled            = (_settings.AffinityMask & bit) != 0;
+
+        if (cpu % cpus_per_row != 0) ImGui::SameLine();
+
+        char label[8];
+        std::snprintf(label, sizeof(label), "%zu", cpu);
+
+        ImGui::PushID(static_cast<int>(cpu));
+        ImGui::BeginDisabled((reserved & bit) != 0);
+        if (ImGui::Checkbox(label, &enabled))
+        {
+            _settings.AffinityMask ^= bit;
+        }
+        ImGui::EndDisabled();
+        ImGui::PopID();
+
+        if ((reserved & bit) != 0 && ImGui::IsItemHovered(ImGuiHoveredFlags_AllowWhenDisabled))
+        {
+            ImGui::SetTooltip("Reserved for the render thread");
+        }
+    }
+
+    if (_settings.AffinityMask == 0)
+    {
+        ImGui::TextDisabled("No CPUs selected, workers run on any CPU not reserved for the render thread.");
+    }
+}
+
+void ExecutorWindow::DrawLanes(const GraphWindow& graph_window)
+{
+    ImGui::TextUnformatted("Execution Lanes");
+
+    constexpr ImGuiTableFlags table_flags =
+        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit;
+
+    std::optional<std::size_t> removed;
+    if (!_settings.Lanes.empty() && ImGui::BeginTable("Lanes", 8, table_flags))
+    {
+        ImGui::TableSetupColumn("##Colour");
+        ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Threads");
+        ImGui::TableSetupColumn("Priority");
+        ImGui::TableSetupColumn("Nodes");
+        ImGui::TableSetupColumn("Queued");
+        ImGui::TableSetupColumn("Computes/s");
+        ImGui::TableSetupColumn("##Remove");
+        ImGui::TableHeadersRow();
+
+        for (std::size_t i = 0; i < _settings.Lanes.size(); ++i)
+        {
+            auto& lane = _settings.Lanes[i];
+
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::TableNextRow();
+
+            ImGui::TableNextColumn();
+            ImVec4 colour = utility::to_ImColor(lane.BandColour);
+            if (ImGui::ColorEdit4("##Colour", &colour.x, ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_NoLabel))
+            {
+                lane.BandColour = utility::to_Colour(colour);
+            }
+
+            ImGui::TableNextColumn();
+            ImGui::SetNextItemWidth(-FLT_MIN);
+            ImGui::InputText("##Name", &lane.Name);
+
+            ImGui::TableNextColumn();
+            int threads = static_cast<int>(lane.Threads);
+            ImGui::SetNextItemWidth(input_width);
+            if (ImGui::InputInt("##Threads", &threads))
+            {
+                lane.Threads = static_cast<std::size_t>(std::clamp(threads, 1, max_threads));
+            }
+            if (lane.Threads == 1 && ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("Nodes on a single thread lane compute one at a time, in order");
+            }
+
+            ImGui::TableNextColumn();
+            int priority = static_cast<int>(lane.Priority);
+            ImGui::SetNextItemWidth(input_width);
+            if (ImGui::Combo("##Priority", &priority, priority_names, IM_ARRAYSIZE(priority_names)))
+            {
+                lane.Priority = static_cast<ThreadPriority>(priority);
+            }
+
+            // Statistics are of the applied lane with this name, edits only take effect once applied.
+            const LaneStats stats = graph_window.GetLaneStats(lane.Name);
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", stats.Nodes);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.Queued));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", stats.ComputeRate);
+
+            ImGui::TableNextColumn();
+            if (ImGui::SmallButton("Remove")) removed = i;
+
+            ImGui::PopID();
+        }
+
+        ImGui::EndTable();
+    }
+
+    if (removed)
+    {
+        _settings.Lanes.erase(_settings.Lanes.begin() + static_cast<std::ptrdiff_t>(*removed));
+    }
+
+    if (ImGui::Button("Add Lane"))
+    {
+        _settings.Lanes.push_back(ExecutionLane{.Name = "Lane " + std::to_string(_settings.Lanes.size() + 1)});
+    }
+
+    if (!LanesValid())
+    {
+        ImGui::TextDisabled("Every lane needs a unique name.");
+    }
+}
+
+bool ExecutorWindow::LanesValid() const
+{
+    std::set<std::string> names;
+    return std::all_of(_settings.Lanes.begin(), _settings.Lanes.end(),
+                       [&](const auto& lane) { return !lane.Name.empty() && names.insert(lane.Name).second; });
+}
+
+FLOW_UI_NAMESPACE_END
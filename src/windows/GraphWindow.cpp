@@ -5,8 +5,11 @@
 
 #include "Config.hpp"
 #include "ConnectionView.hpp"
+#include "FramePacer.hpp"
 #include "NodeView.hpp"
 #include "PortView.hpp"
+#include "Profiler.hpp"
+#include "ValueFormatter.hpp"
 #include "ViewFactory.hpp"
 #include "utilities/Conversions.hpp"
 
@@ -21,7 +24,9 @@
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
+#include <optional>
 #include <set>
+#include <utility>
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ImVec2, x, y);
 
@@ -30,6 +35,26 @@ FLOW_UI_NAMESPACE_START
 using namespace ax;
 namespace ed = ax::NodeEditor;
 
+namespace
+{
+/**
+ * @brief Loads the modules of node classes used by a flow that are declared but not loaded yet.
+ */
+void RequireNodeClasses(const std::shared_ptr<NodeFactory>& factory, const json& flow_json)
+{
+    auto view_factory = std::dynamic_pointer_cast<ViewFactory>(factory);
+    if (!view_factory || !flow_json.contains("nodes")) return;
+
+    for (const auto& node_json : flow_json["nodes"])
+    {
+        if (const auto class_name = node_json.find("class"); class_name != node_json.end())
+        {
+            view_factory->RequireNodeClass(class_name->get<std::string>());
+        }
+    }
+}
+} // namespace
+
 void ContextMenu::operator()() noexcept
 {
     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(5, 5));
@@ -70,39 +95,13 @@ void ContextMenu::operator()() noexcept
 
     ImGui::EndHorizontal();
 
-    auto registered_nodes = _factory->GetCategories();
-
-    if (!node_lookup.empty())
-    {
-        auto partial_match_func = [&](const auto& entry) -> bool {
-            auto [_, class_name]     = entry;
-            std::string display_name = _factory->GetFriendlyName(class_name);
-            std::string filter       = node_lookup;
-
-            const auto& to_lower = [](unsigned char c) { return static_cast<unsigned char>(std::tolower(c)); };
-            std::transform(filter.begin(), filter.end(), filter.begin(), to_lower);
-            std::transform(class_name.begin(), class_name.end(), class_name.begin(), to_lower);
-            std::transform(display_name.begin(), display_name.end(), display_name.begin(), to_lower);
-
-            return std::string_view(display_name).find(filter) == std::string_view::npos &&
-                   std::string_view(class_name).find(filter) == std::string_view::npos;
-        };
-
-        std::erase_if(registered_nodes, partial_match_func);
-    }
+    const auto matches = _search.Filter(*_factory, node_lookup);
 
     if (ImGui::BeginChild("Categories"))
     {
-        std::set<std::string> categories;
-        for (const auto& [category, _] : registered_nodes)
-        {
-            categories.insert(category);
-        }
-
-        for (const auto& category : categories)
-        {
-            DrawPopupCategory(category, registered_nodes);
-        }
+        NodeSearch::ForEachCategory(matches, [this](const std::string& category, const auto& entries) {
+            DrawPopupCategory(category, entries);
+        });
 
         ImGui::EndChild();
     }
@@ -113,15 +112,14 @@ void ContextMenu::operator()() noexcept
     ImGui::PopStyleVar();
 }
 
-void ContextMenu::DrawPopupCategory(const std::string& category, const flow::CategoryMap& registered_nodes)
+void ContextMenu::DrawPopupCategory(const std::string& category, std::span<const NodeSearch::Entry* const> entries)
 {
     if (!ImGui::TreeNodeEx(category.c_str(), node_lookup.empty() ? 0 : ImGuiTreeNodeFlags_DefaultOpen)) return;
 
-    auto [begin_it, end_it] = registered_nodes.equal_range(category);
-    for (auto it = begin_it; it != end_it; ++it)
+    for (const auto* entry : entries)
     {
-        auto class_name   = it->second;
-        auto display_name = _factory->GetFriendlyName(class_name);
+        const auto& class_name   = entry->second;
+        const auto& display_name = _search.GetFriendlyName(*_factory, class_name);
 
         ImGui::Bullet();
         if (ImGui::MenuItem(display_name.c_str()))
@@ -153,15 +151,14 @@ inline void DrawLabel(const char* label, ImColor color)
     ImGui::TextUnformatted(label);
 };
 
-inline std::pair<ImVec2, ImVec2> GetContainerNodeBounds()
+inline std::pair<ImVec2, ImVec2> GetContainerNodeBounds(const std::vector<std::uint64_t>& ids)
 {
-    ed::NodeId ids[128];
-    int result = ed::GetSelectedNodes(ids, 128);
-
     std::vector<std::pair<ImVec2, ImVec2>> node_bounds;
-    std::for_each_n(std::begin(ids), result, [&](const auto& id) {
+    node_bounds.reserve(ids.size());
+    for (const auto& id : ids)
+    {
         node_bounds.emplace_back(ed::GetNodePosition(id), ed::GetNodePosition(id) + ed::GetNodeSize(id));
-    });
+    }
 
     if (node_bounds.empty()) return {{}, {}};
 
@@ -265,7 +262,7 @@ GraphWindow::GraphWindow(std::shared_ptr<flow::Graph> graph)
     _graph->OnNodeAdded.Bind("CreateNodeView", [this](const auto& n) {
         const auto factory = std::dynamic_pointer_cast<ViewFactory>(GetEnv()->GetFactory());
         auto node_view     = factory->CreateNodeView(n);
-        _item_views.emplace(node_view->ID(), node_view);
+        AddNodeView(node_view, n);
         ed::SetNodePosition(node_view->ID(), {_open_popup_position.x, _open_popup_position.y});
 
         if (auto start_pin = _new_node_link_pin)
@@ -273,11 +270,7 @@ GraphWindow::GraphWindow(std::shared_ptr<flow::Graph> graph)
             auto& pins = start_pin->Kind == PortType::Input ? node_view->Outputs : node_view->Inputs;
             for (auto& pin : pins)
             {
-                if (!start_pin->CanLink(pin) && !(factory->IsConvertible(start_pin->Type(), pin->Type()) ||
-                                                  factory->IsConvertible(pin->Type(), start_pin->Type())))
-                {
-                    continue;
-                }
+                if (!start_pin->CanLink(pin)) continue;
 
                 auto end_pin = pin;
                 if (start_pin->Kind == PortType::Input) std::swap(start_pin, end_pin);
@@ -287,8 +280,7 @@ GraphWindow::GraphWindow(std::shared_ptr<flow::Graph> graph)
                 const auto& conn       = _graph->ConnectNodes(start_node->NodeID, IndexableName{start_pin->Name},
                                                               end_node->NodeID, IndexableName{end_pin->Name});
 
-                _links.emplace(std::hash<flow::UUID>{}(conn->ID()),
-                               ConnectionView{conn->ID(), start_pin->ID, end_pin->ID, start_pin->GetColour()});
+                AddLink(conn, *start_pin, *end_pin);
                 break;
             }
         }
@@ -302,7 +294,13 @@ GraphWindow::~GraphWindow()
     _graph->Visit([](const auto& node) { return node->Stop(); });
     _graph->Clear();
 
-    _links.clear();
+    {
+        std::lock_guard _(_links_mutex);
+        _links.clear();
+    }
+
+    _node_links.clear();
+    _class_nodes.clear();
 
     if (ed::GetCurrentEditor() == std::bit_cast<ed::EditorContext*>(_editor_ctx.get()))
     {
@@ -351,7 +349,9 @@ try
         if (auto payload = ImGui::AcceptDragDropPayload("NewNode"))
         {
             std::string class_name   = reinterpret_cast<const char*>(payload->Data);
-            std::string display_name = GetEnv()->GetFactory()->GetFriendlyName(class_name);
+            const auto factory       = std::dynamic_pointer_cast<ViewFactory>(GetEnv()->GetFactory());
+            std::string display_name = factory ? factory->GetCatalogFriendlyName(class_name)
+                                               : GetEnv()->GetFactory()->GetFriendlyName(class_name);
 
             _graph->OnNodeAdded.Bind(
                 "SetPos", [](auto&& n) { ed::SetNodePosition(std::hash<UUID>{}(n->ID()), ImGui::GetMousePos()); });
@@ -366,9 +366,17 @@ try
 
     {
         std::lock_guard _(_mutex);
+        // Port dimming only changes when a different pin is dragged or new views are added, so it is not recomputed
+        // every frame.
+        const bool update_connectables = _connectables_dirty || _shown_link_pin != _new_link_pin;
+        _shown_link_pin                = _new_link_pin;
+        _connectables_dirty            = false;
+
         for (auto& [__, item] : _item_views)
         {
-            item->ShowConnectables(_new_link_pin);
+            FLOW_UI_PROFILE_SCOPE("GraphItemView::Draw");
+
+            if (update_connectables) item->ShowConnectables(_new_link_pin);
             item->Draw();
         }
 
@@ -401,6 +409,25 @@ try
         _new_node_link_pin  = nullptr;
     }
 
+    if (GetConfig().NodeHeatmap != NodeHeatmapMode::None)
+    {
+        const auto hovered_id = ed::GetHoveredNode().Get();
+        if (auto node = hovered_id ? FindNode(hovered_id) : nullptr; node && ImGui::BeginTooltip())
+        {
+            node->DrawComputeStats();
+            ImGui::EndTooltip();
+        }
+    }
+
+    if (const auto hovered_id = ed::GetHoveredLink().Get(); hovered_id != 0)
+    {
+        if (auto link = _links.find(hovered_id); link != _links.end() && ImGui::BeginTooltip())
+        {
+            link->second.DrawStats();
+            ImGui::EndTooltip();
+        }
+    }
+
     ed::Resume();
 
     if (_get_popup_location)
@@ -432,6 +459,26 @@ try
                 CreateComment();
             }
 
+            if (!_executor_settings.Lanes.empty() && ImGui::BeginMenu("Execution Lane"))
+            {
+                const std::string current = GetNodeLane(node->NodeID);
+                std::optional<std::string> selected;
+
+                if (ImGui::MenuItem("Default", nullptr, current.empty())) selected = "";
+                for (const auto& lane : _executor_settings.Lanes)
+                {
+                    if (ImGui::MenuItem(lane.Name.c_str(), nullptr, lane.Name == current)) selected = lane.Name;
+                }
+
+                ImGui::EndMenu();
+
+                if (selected && *selected != current)
+                {
+                    SetNodeLane(node->NodeID, *selected);
+                    MarkDirty(true);
+                }
+            }
+
             ImGui::Separator();
 
             if (ed::HasAnyLinks(context_node_id))
@@ -549,6 +596,7 @@ void GraphWindow::EndDraw()
 {
     if (_active)
     {
+        UpdateSelection();
         ed::End();
     }
 
@@ -556,6 +604,30 @@ void GraphWindow::EndDraw()
     ImGui::PopStyleVar();
 }
 
+void GraphWindow::UpdateSelection()
+{
+    if (!ed::HasSelectionChanged()) return;
+
+    std::vector<ed::NodeId> ids(static_cast<std::size_t>(ed::GetSelectedObjectCount()));
+    ids.resize(static_cast<std::size_t>(ed::GetSelectedNodes(ids.data(), static_cast<int>(ids.size()))));
+
+    _selected_ids.clear();
+    _selected_nodes.clear();
+    for (const auto& id : ids)
+    {
+        _selected_ids.push_back(id.Get());
+        if (auto node_view = FindNode(id.Get()))
+        {
+            if (auto node = _graph->GetNode(node_view->NodeID))
+            {
+                _selected_nodes.emplace(id.Get(), std::move(node));
+            }
+        }
+    }
+
+    ++_selection_version;
+}
+
 std::shared_ptr<NodeView> GraphWindow::FindNode(std::uint64_t id) const
 {
     if (!id)
@@ -633,36 +705,245 @@ std::shared_ptr<CommentView> GraphWindow::FindComment(std::uint64_t id) const
 
 void GraphWindow::DeleteNode(std::uint64_t id)
 {
-    if (!_item_views.contains(id)) return;
+    if (EraseNode(id)) ++_selection_version;
+}
+
+std::size_t GraphWindow::RemoveNodesOfClass(const std::string& class_name)
+{
+    const auto found = _class_nodes.find(class_name);
+    if (found == _class_nodes.end()) return 0;
+
+    const auto ids = std::move(found->second);
+    _class_nodes.erase(found);
+
+    SetCurrentGraph();
+
+    bool selection_changed = false;
+    for (const auto& id : ids)
+    {
+        selection_changed |= EraseNode(id);
+        ed::DeleteNode(id);
+    }
+
+    if (selection_changed) ++_selection_version;
+    MarkDirty(true);
+
+    return ids.size();
+}
+
+std::vector<NodeSnapshot> GraphWindow::DetachNodesOfClasses(const std::unordered_set<std::string>& class_names)
+{
+    std::vector<std::uint64_t> ids;
+    for (const auto& class_name : class_names)
+    {
+        if (const auto found = _class_nodes.find(class_name); found != _class_nodes.end())
+        {
+            ids.insert(ids.end(), found->second.begin(), found->second.end());
+        }
+    }
+
+    std::vector<NodeSnapshot> snapshots;
+    if (ids.empty()) return snapshots;
+
+    SetCurrentGraph();
+
+    // Every node is saved before any is removed, so connections between detached nodes are kept as well.
+    for (const auto& id : ids)
+    {
+        auto view = FindNode(id);
+        if (!view) continue;
+
+        if (auto node = _graph->GetNode(view->NodeID))
+        {
+            snapshots.push_back(SnapshotNode(node));
+            node->Stop();
+        }
+    }
+
+    // Only the views are erased. Deleting them from the editor as well would queue deletes that remove the
+    // restored nodes, which keep the same ids, on the next frame.
+    bool selection_changed = false;
+    for (const auto& id : ids)
+    {
+        selection_changed |= EraseNode(id);
+    }
+
+    if (selection_changed) ++_selection_version;
+
+    return snapshots;
+}
+
+void GraphWindow::RestoreNodes(const std::vector<NodeSnapshot>& snapshots)
+{
+    if (snapshots.empty()) return;
+
+    SetCurrentGraph();
 
-    const auto& node = std::dynamic_pointer_cast<NodeView>(_item_views.at(id));
-    if (node)
+    const auto& lanes = _executor_settings.Lanes;
+    std::vector<flow::SharedNode> restored;
+    for (const auto& snapshot : snapshots)
     {
-        std::vector<std::uint64_t> links_to_delete;
-        for (const auto& [link_id, link] : _links)
+        const auto lane =
+            std::find_if(lanes.begin(), lanes.end(), [&](const auto& l) { return l.Name == snapshot.Lane; });
+
+        try
         {
-            if (std::any_of(node->Inputs.begin(), node->Inputs.end(),
-                            [&, end_pin_id = link.EndPortID](const auto& in) { return in->ID == end_pin_id; }))
+            restored.push_back(RecreateNode(snapshot, lane != lanes.end() ? GetLaneEnv(*lane) : GetEnv()));
+        }
+        catch (const std::exception& e)
+        {
+            SPDLOG_ERROR("Could not restore node '{}': {}", snapshot.Name, e.what());
+            continue;
+        }
+
+        if (lane != lanes.end())
+        {
+            _node_lanes[snapshot.ID] = lane->Name;
+            if (auto view = FindNode(std::hash<flow::UUID>{}(snapshot.ID))) view->LaneColour = lane->BandColour;
+        }
+    }
+
+    // Connections between two restored nodes are in both snapshots, but are only made once.
+    std::unordered_set<flow::UUID> connected;
+    for (const auto& snapshot : snapshots)
+    {
+        for (const auto& conn : snapshot.Connections)
+        {
+            if (!connected.insert(conn->ID()).second) continue;
+            if (!_graph->GetNode(conn->StartNodeID()) || !_graph->GetNode(conn->EndNodeID())) continue;
+
+            try
+            {
+                OnLoadConnection(_graph->ConnectNodes(conn->StartNodeID(), conn->StartPortKey(), conn->EndNodeID(),
+                                                      conn->EndPortKey()));
+            }
+            catch (const std::exception& e)
             {
-                links_to_delete.push_back(link_id);
+                SPDLOG_WARN("Could not restore a connection of node '{}': {}", snapshot.Name, e.what());
             }
+        }
+    }
+
+    for (const auto& node : restored)
+    {
+        node->GetEnv()->AddTask([=] { node->Start(); });
+    }
+}
+
+bool GraphWindow::EraseNode(std::uint64_t id)
+{
+    const auto item = _item_views.find(id);
+    if (item == _item_views.end()) return false;
 
-            if (std::any_of(node->Outputs.begin(), node->Outputs.end(),
-                            [&, start_pin_id = link.StartPortID](const auto& out) { return out->ID == start_pin_id; }))
+    if (const auto node = std::dynamic_pointer_cast<NodeView>(item->second))
+    {
+        if (const auto links = _node_links.find(id); links != _node_links.end())
+        {
+            // DeleteLink updates the index, so the node's links are copied out first.
+            const std::vector<std::uint64_t> links_to_delete(links->second.begin(), links->second.end());
+            for (const auto& link_id : links_to_delete)
             {
-                links_to_delete.push_back(link_id);
+                DeleteLink(link_id);
             }
+
+            _node_links.erase(id);
         }
 
-        for (const auto& link_id : links_to_delete)
+        if (const auto flow_node = _graph->GetNode(node->NodeID))
         {
-            DeleteLink(link_id);
+            if (auto nodes = _class_nodes.find(std::string{flow_node->GetClass()}); nodes != _class_nodes.end())
+            {
+                nodes->second.erase(id);
+                if (nodes->second.empty()) _class_nodes.erase(nodes);
+            }
         }
 
         _graph->RemoveNodeByID(node->NodeID);
+        _node_lanes.erase(node->NodeID);
+        GetValueFormatter().Evict(node->NodeID);
+        _connectables_dirty = true;
     }
 
-    _item_views.erase(id);
+    _item_views.erase(item);
+
+    const auto selected = std::find(_selected_ids.begin(), _selected_ids.end(), id);
+    if (selected == _selected_ids.end()) return false;
+
+    _selected_ids.erase(selected);
+    _selected_nodes.erase(id);
+
+    return true;
+}
+
+void GraphWindow::SetNodeLane(const flow::UUID& node_id, const std::string& lane)
+{
+    auto node = _graph->GetNode(node_id);
+    if (!node) return;
+
+    const auto& lanes = _executor_settings.Lanes;
+    const auto found  = std::find_if(lanes.begin(), lanes.end(), [&](const auto& l) { return l.Name == lane; });
+    if (!lane.empty() && found == lanes.end())
+    {
+        SPDLOG_WARN("Node '{}' is assigned to unknown execution lane '{}'", node->GetName(), lane);
+        return;
+    }
+
+    auto env = lane.empty() ? GetEnv() : GetLaneEnv(*found);
+    if (node->GetEnv() != env) node = MoveNode(node, std::move(env));
+
+    std::optional<Colour> band;
+    if (lane.empty())
+    {
+        _node_lanes.erase(node_id);
+    }
+    else
+    {
+        _node_lanes[node_id] = lane;
+        band                 = found->BandColour;
+    }
+
+    if (auto view = FindNode(std::hash<flow::UUID>{}(node_id))) view->LaneColour = band;
+}
+
+std::string GraphWindow::GetNodeLane(const flow::UUID& node_id) const
+{
+    const auto lane = _node_lanes.find(node_id);
+    return lane != _node_lanes.end() ? lane->second : std::string{};
+}
+
+LaneStats GraphWindow::GetLaneStats(const std::string& lane) const
+{
+    LaneStats stats;
+    std::uint64_t delivered = 0;
+    std::uint64_t computed  = 0;
+
+    for (const auto& [node_id, node_lane] : _node_lanes)
+    {
+        if (node_lane != lane) continue;
+
+        auto view = FindNode(std::hash<flow::UUID>{}(node_id));
+        if (!view) continue;
+
+        ++stats.Nodes;
+        stats.ComputeRate += view->GetCallRate();
+        computed += view->GetComputeStats().Calls.load(std::memory_order_relaxed);
+
+        // The pool does not expose its queue, so the depth is estimated from what arrived but has not started yet.
+        // Link and compute counters both start with the views, which are recreated when a node changes lanes.
+        for (const auto& conn : _graph->GetConnections().FindConnections(node_id))
+        {
+            if (conn->EndNodeID() != node_id) continue;
+
+            if (auto link = _links.find(std::hash<flow::UUID>{}(conn->ID())); link != _links.end())
+            {
+                delivered += link->second.GetEventCount();
+            }
+        }
+    }
+
+    stats.Queued = delivered > computed ? delivered - computed : 0;
+
+    return stats;
 }
 
 bool GraphWindow::DeleteLink(std::uint64_t id)
@@ -682,20 +963,36 @@ bool GraphWindow::DeleteLink(std::uint64_t id)
 
     _graph->DisconnectNodes(start_node->NodeID, start_pin->Key(), end_node->NodeID, end_pin->Key());
 
+    for (const auto& node_id : {start_pin->NodeViewID, end_pin->NodeViewID})
+    {
+        if (auto links = _node_links.find(node_id); links != _node_links.end()) links->second.erase(id);
+    }
+
+    std::lock_guard _(_links_mutex);
     return _links.erase(id) != 0;
 }
 
-void GraphWindow::ShowLinkFlowing(const flow::UUID& node_id, const IndexableName& key)
+void GraphWindow::ShowLinkFlowing(const flow::UUID& node_id, const IndexableName& key, const SharedNodeData& data)
 {
     auto&& conns = _graph->GetConnections().FindConnections(node_id, key);
+
+    // Outputs are set on the executor threads, while links are only added and removed on the UI thread under the lock.
+    std::lock_guard _(_links_mutex);
     for (const auto& conn : conns)
     {
-        _links.at(std::hash<flow::UUID>{}(conn->ID())).SetFlowing(true);
+        if (auto link = _links.find(std::hash<flow::UUID>{}(conn->ID())); link != _links.end())
+        {
+            link->second.RecordEvent(data);
+        }
     }
+
+    GetFramePacer().Wake();
 }
 
 void GraphWindow::CreateItems()
 {
+    FLOW_UI_PROFILE_SCOPE("GraphWindow::CreateItems");
+
     if (!ed::BeginCreate(ImColor(255, 255, 255), 2.0f))
     {
         _new_link_pin = nullptr;
@@ -718,6 +1015,10 @@ void GraphWindow::CreateItems()
                 std::swap(start_pin_id, end_pin_id);
             }
 
+            const auto factory       = std::dynamic_pointer_cast<ViewFactory>(GetEnv()->GetFactory());
+            const auto compatibility = factory->GetTypeRegistry().GetCompatibility(start_pin->GetTypeID(),
+                                                                                    end_pin->GetTypeID());
+
             if (&end_pin == &start_pin || &start_pin->NodeViewID == &end_pin->NodeViewID || end_pin->IsConnected())
             {
                 ed::RejectNewItem(ImColor(255, 0, 0), 2.0f);
@@ -727,21 +1028,17 @@ void GraphWindow::CreateItems()
                 DrawLabel("x Incompatible Pin Kind", ImColor(45, 32, 32, 180));
                 ed::RejectNewItem(ImColor(255, 0, 0), 2.0f);
             }
-            else if (!GetEnv()->GetFactory()->IsConvertible(start_pin->Type(), end_pin->Type()))
+            else if (compatibility == TypeCompatibility::Incompatible)
             {
                 DrawLabel("x Incompatible Pin Type", ImColor(45, 32, 32, 180));
                 ed::RejectNewItem(ImColor(255, 128, 128), 1.0f);
             }
             else
             {
-                std::string label = "+ Create Link";
-                if (start_pin->Type() != end_pin->Type() &&
-                    GetEnv()->GetFactory()->IsConvertible(start_pin->Type(), end_pin->Type()))
-                {
-                    label = "+ Create Converting Link";
-                }
+                const char* label = compatibility == TypeCompatibility::Convertible ? "+ Create Converting Link"
+                                                                                    : "+ Create Link";
 
-                DrawLabel(label.c_str(), ImColor(32, 45, 32, 180));
+                DrawLabel(label, ImColor(32, 45, 32, 180));
                 if (ed::AcceptNewItem(ImColor(128, 255, 128), 4.0f))
                 {
                     const auto& start_node = FindNode(start_pin->NodeViewID);
@@ -749,8 +1046,7 @@ void GraphWindow::CreateItems()
                     const auto& conn       = _graph->ConnectNodes(start_node->NodeID, IndexableName{start_pin->Name},
                                                                   end_node->NodeID, IndexableName{end_pin->Name});
 
-                    _links.emplace(std::hash<flow::UUID>{}(conn->ID()),
-                                   ConnectionView{conn->ID(), start_pin->ID, end_pin->ID, start_pin->GetColour()});
+                    AddLink(conn, *start_pin, *end_pin);
                 }
             }
         }
@@ -781,6 +1077,8 @@ void GraphWindow::CreateItems()
 
 void GraphWindow::CleanupDeadItems()
 {
+    FLOW_UI_PROFILE_SCOPE("GraphWindow::CleanupDeadItems");
+
     if (!ed::BeginDelete()) return ed::EndDelete();
 
     std::uint64_t link_id = 0;
@@ -809,11 +1107,12 @@ void GraphWindow::OnLoadNode(const flow::SharedNode& node, const json& position_
     {
         auto view_factory = std::dynamic_pointer_cast<ViewFactory>(GetEnv()->GetFactory());
         node_view         = view_factory->CreateNodeView(node);
-        node->OnSetOutput.Bind("ShowLinkFlowing", [=, this, node_id = node->ID()](const IndexableName& key, auto) {
-            ShowLinkFlowing(node_id, key);
-        });
+        node->OnSetOutput.Bind("ShowLinkFlowing",
+                               [=, this, node_id = node->ID()](const IndexableName& key, const auto& data) {
+                                   ShowLinkFlowing(node_id, key, data);
+                               });
 
-        _item_views.emplace(node_view->ID(), node_view);
+        AddNodeView(node_view, node);
     }
 
     const ImVec2 location(position_json["x"], position_json["y"]);
@@ -833,21 +1132,45 @@ void GraphWindow::OnLoadConnection(const flow::SharedConnection& connection)
     auto end_pin   = std::find_if(end_node->Inputs.begin(), end_node->Inputs.end(),
                                   [&](auto&& pin) { return IndexableName{pin->Name} == connection->EndPortKey(); });
 
-    _links.emplace(std::hash<flow::UUID>{}(connection->ID()),
-                   ConnectionView{connection->ID(), (*start_pin)->ID, (*end_pin)->ID, (*start_pin)->GetColour()});
+    AddLink(connection, **start_pin, **end_pin);
+}
+
+void GraphWindow::AddNodeView(const std::shared_ptr<NodeView>& node_view, const flow::SharedNode& node)
+{
+    _item_views.emplace(node_view->ID(), node_view);
+    _class_nodes[std::string{node->GetClass()}].insert(node_view->ID());
+    _connectables_dirty = true;
+}
+
+void GraphWindow::AddLink(const flow::SharedConnection& connection, const PortView& start_pin, const PortView& end_pin)
+{
+    const auto link_id = std::hash<flow::UUID>{}(connection->ID());
+    {
+        std::lock_guard _(_links_mutex);
+        _links.emplace(link_id, ConnectionView{connection->ID(), start_pin.ID, end_pin.ID, start_pin.GetTypeInfo()});
+    }
+
+    _node_links[start_pin.NodeViewID].insert(link_id);
+    _node_links[end_pin.NodeViewID].insert(link_id);
 }
 
 flow::SharedNode GraphWindow::CreateNode(const std::string& class_name, const std::string& display_name)
 {
+    if (auto factory = std::dynamic_pointer_cast<ViewFactory>(GetEnv()->GetFactory()))
+    {
+        factory->RequireNodeClass(class_name);
+    }
+
     auto new_node = GetEnv()->GetFactory()->CreateNode(class_name, flow::UUID{}, display_name, GetEnv());
     if (!new_node)
     {
         throw std::runtime_error("Failed to create node: " + display_name);
     }
 
-    new_node->OnSetOutput.Bind("ShowLinkFlowing", [=, this, node_id = new_node->ID()](const IndexableName& key, auto) {
-        ShowLinkFlowing(node_id, key);
-    });
+    new_node->OnSetOutput.Bind("ShowLinkFlowing",
+                               [=, this, node_id = new_node->ID()](const IndexableName& key, const auto& data) {
+                                   ShowLinkFlowing(node_id, key, data);
+                               });
 
     _graph->AddNode(new_node);
     GetEnv()->AddTask([=] { new_node->Start(); });
@@ -855,6 +1178,90 @@ flow::SharedNode GraphWindow::CreateNode(const std::string& class_name, const st
     return new_node;
 }
 
+flow::SharedNode GraphWindow::MoveNode(const flow::SharedNode& node, std::shared_ptr<flow::Env> env)
+{
+    const auto view_id    = std::hash<flow::UUID>{}(node->ID());
+    const ImVec2 position = ed::GetNodePosition(view_id);
+
+    // Adding the copy creates its view, which must not be linked to a pin that is being dragged.
+    auto link_pin = std::exchange(_new_node_link_pin, nullptr);
+
+    flow::SharedNode new_node;
+    try
+    {
+        new_node = MoveNodeToEnv(*_graph, node, env, [&](const auto&) { DeleteNode(view_id); });
+    }
+    catch (...)
+    {
+        _new_node_link_pin = std::move(link_pin);
+        throw;
+    }
+
+    _new_node_link_pin = std::move(link_pin);
+
+    new_node->OnSetOutput.Bind("ShowLinkFlowing",
+                               [=, this, node_id = new_node->ID()](const IndexableName& key, const auto& data) {
+                                   ShowLinkFlowing(node_id, key, data);
+                               });
+    ed::SetNodePosition(view_id, position);
+
+    for (const auto& conn : _graph->GetConnections().FindConnections(new_node->ID()))
+    {
+        OnLoadConnection(conn);
+    }
+
+    env->AddTask([=] { new_node->Start(); });
+
+    return new_node;
+}
+
+NodeSnapshot GraphWindow::SnapshotNode(const flow::SharedNode& node) const
+{
+    return NodeSnapshot{
+        .ID          = node->ID(),
+        .Class       = std::string{node->GetClass()},
+        .Name        = node->GetName(),
+        .State       = node->Save(),
+        .Position    = ed::GetNodePosition(std::hash<flow::UUID>{}(node->ID())),
+        .Lane        = GetNodeLane(node->ID()),
+        .Connections = _graph->GetConnections().FindConnections(node->ID()),
+    };
+}
+
+flow::SharedNode GraphWindow::RecreateNode(const NodeSnapshot& snapshot, std::shared_ptr<flow::Env> env)
+{
+    const auto factory = GetEnv()->GetFactory();
+    auto node          = factory->CreateNode(snapshot.Class, snapshot.ID, snapshot.Name, std::move(env));
+    if (!node)
+    {
+        throw std::runtime_error("Failed to recreate node: " + snapshot.Name);
+    }
+
+    node->Restore(snapshot.State);
+    node->OnSetOutput.Bind("ShowLinkFlowing",
+                           [=, this, node_id = node->ID()](const IndexableName& key, const auto& data) {
+                               ShowLinkFlowing(node_id, key, data);
+                           });
+
+    // Adding the node creates its view, which must not be linked to a pin that is being dragged.
+    auto link_pin = std::exchange(_new_node_link_pin, nullptr);
+    _graph->AddNode(node);
+    _new_node_link_pin = std::move(link_pin);
+
+    const ImVec2 position = snapshot.Position;
+    ed::SetNodePosition(std::hash<flow::UUID>{}(snapshot.ID), position);
+
+    return node;
+}
+
+const std::shared_ptr<flow::Env>& GraphWindow::GetLaneEnv(const ExecutionLane& lane)
+{
+    auto& env = _lane_envs[lane.Name];
+    if (!env) env = CreateLaneExecutor(GetEnv()->GetFactory(), _executor_settings, lane);
+
+    return env;
+}
+
 json GraphWindow::SaveFlow()
 {
     json graph_json = *_graph;
@@ -869,6 +1276,11 @@ json GraphWindow::SaveFlow()
             {"x", pos.x},
             {"y", pos.y},
         };
+
+        if (auto lane = _node_lanes.find(id); lane != _node_lanes.end())
+        {
+            node_json["lane"] = lane->second;
+        }
     }
 
     std::vector<json> comments_json;
@@ -887,17 +1299,27 @@ json GraphWindow::SaveFlow()
     MarkDirty(false);
 
     // TODO(trigaux): Don't breakout the graph json, but instead save editor data to another file.
-    return {
+    json flow_json = {
         {"nodes", graph_json["nodes"]},
         {"connections", graph_json["connections"]},
         {"comments", comments_json},
     };
+
+    if (_executor_settings != ExecutorSettings{})
+    {
+        flow_json["executor"] = _executor_settings;
+    }
+
+    return flow_json;
 }
 
 void GraphWindow::LoadFlow(const json& j)
 {
     if (_dirty) MarkDirty(false);
 
+    if (j.contains("executor")) j["executor"].get_to(_executor_settings);
+
+    RequireNodeClasses(GetEnv()->GetFactory(), j);
     j.get_to(*_graph);
     _graph->Visit([](const auto& node) { node->Start(); });
 
@@ -918,6 +1340,14 @@ void GraphWindow::LoadFlow(const json& j)
         OnLoadConnection(conn);
     }
 
+    for (const auto& node_json : nodes_json)
+    {
+        if (const auto lane = node_json.find("lane"); lane != node_json.end())
+        {
+            SetNodeLane(flow::UUID{node_json["id"]}, lane->get<std::string>());
+        }
+    }
+
     if (!j.contains("comments")) return;
 
     const std::vector<json>& comments_json = j["comments"].get_ref<const std::vector<json>&>();
@@ -934,28 +1364,16 @@ void GraphWindow::LoadFlow(const json& j)
 
 json GraphWindow::CopySelection()
 {
-    ed::NodeId ids[128];
-    int result = ed::GetSelectedNodes(ids, 128);
-
-    std::map<ed::NodeId, flow::UUID> node_ids;
-    std::for_each_n(ids, result, [&](const auto& id) { node_ids.emplace(id, flow::UUID{}); });
-
     std::vector<json> nodes_json;
     std::vector<json> connections_json;
 
     auto&& connections = _graph->GetConnections();
-    _graph->Visit([&](auto node) {
-        const std::uint64_t id = std::hash<flow::UUID>{}(node->ID());
-
-        if (!node_ids.contains(id))
-        {
-            return;
-        }
-
+    for (const auto& [id, node] : _selected_nodes)
+    {
         auto&& conns = connections.FindConnections(node->ID());
         for (const auto& connection : conns)
         {
-            if (!node_ids.contains(std::hash<flow::UUID>{}(connection->EndNodeID())))
+            if (!_selected_nodes.contains(std::hash<flow::UUID>{}(connection->EndNodeID())))
             {
                 continue;
             }
@@ -968,8 +1386,13 @@ json GraphWindow::CopySelection()
         node_json["id"]       = std::string(node->ID());
         node_json["position"] = ed::GetNodePosition(id);
 
+        if (auto lane = _node_lanes.find(node->ID()); lane != _node_lanes.end())
+        {
+            node_json["lane"] = lane->second;
+        }
+
         nodes_json.push_back(std::move(node_json));
-    });
+    }
 
     return {
         {"nodes", nodes_json},
@@ -1005,14 +1428,15 @@ void GraphWindow::CreateNodesAction(const json& SPDLOG_json)
         const auto factory = std::dynamic_pointer_cast<ViewFactory>(GetEnv()->GetFactory());
         auto node_view     = factory->CreateNodeView(node);
 
-        node->OnSetOutput.Bind("ShowLinkFlowing",
-                                 [=, this, id = node->ID()](const auto& key, auto) { ShowLinkFlowing(id, key); });
+        node->OnSetOutput.Bind("ShowLinkFlowing", [=, this, id = node->ID()](const auto& key, const auto& data) {
+            ShowLinkFlowing(id, key, data);
+        });
 
         const ImVec2 pos     = position_json;
         const ImVec2 new_pos = ImGui::GetMousePos() + (pos - first_pos);
         ed::SetNodePosition(node_view->ID(), new_pos);
 
-        _item_views.emplace(std::hash<flow::UUID>{}(node->ID()), std::move(node_view));
+        AddNodeView(node_view, node);
 
         node->Start();
     };
@@ -1030,10 +1454,10 @@ void GraphWindow::CreateNodesAction(const json& SPDLOG_json)
         auto end_pin   = std::find_if(end_node->Inputs.begin(), end_node->Inputs.end(),
                                       [&](auto&& pin) { return IndexableName{pin->Name} == connection->EndPortKey(); });
 
-        _links.emplace(std::hash<flow::UUID>{}(connection->ID()),
-                       ConnectionView{connection->ID(), (*start_pin)->ID, (*end_pin)->ID, (*start_pin)->GetColour()});
+        AddLink(connection, **start_pin, **end_pin);
     };
 
+    RequireNodeClasses(GetEnv()->GetFactory(), new_diff);
     new_diff.get_to(*_graph);
 
     for (const auto& node_json : nodes)
@@ -1046,6 +1470,14 @@ void GraphWindow::CreateNodesAction(const json& SPDLOG_json)
         OnLoadConnection(conn);
     }
 
+    for (const auto& node_json : nodes)
+    {
+        if (const auto lane = node_json.find("lane"); lane != node_json.end())
+        {
+            SetNodeLane(flow::UUID{node_json["id"]}, lane->get<std::string>());
+        }
+    }
+
     _undo_history.push(Action{ActionType::Create, new_diff});
 }
 
@@ -1054,10 +1486,21 @@ void GraphWindow::DeleteNodesAction(Action& action)
     auto&& nodes = action.Info["nodes"].get_ref<std::vector<json>&>();
     for (auto& node : nodes)
     {
-        std::uint64_t id = std::hash<flow::UUID>{}(flow::UUID{node["id"]});
+        const flow::UUID node_id{node["id"]};
+        std::uint64_t id = std::hash<flow::UUID>{}(node_id);
         ImVec2 pos       = ed::GetNodePosition(id);
         node["position"] = pos;
 
+        // The lane can have changed since the node was created, and is forgotten once the node is deleted.
+        if (auto lane = _node_lanes.find(node_id); lane != _node_lanes.end())
+        {
+            node["lane"] = lane->second;
+        }
+        else
+        {
+            node.erase("lane");
+        }
+
         ed::BreakLinks(static_cast<ed::NodeId>(id));
         ed::DeleteNode(id);
     }
@@ -1103,7 +1546,7 @@ void GraphWindow::RedoChange()
 
 void GraphWindow::CreateComment()
 {
-    const auto [min_pos, size] = GetContainerNodeBounds();
+    const auto [min_pos, size] = GetContainerNodeBounds(_selected_ids);
     if (min_pos == size || size == ImVec2(0.f, 0.f)) return;
 
     auto comment   = std::make_shared<CommentView>(CommentView::CommentSize{size.x, size.y});
@@ -0,0 +1,148 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "ModuleBuilder.hpp"
+
+#include "utilities/Process.hpp"
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+FLOW_UI_NAMESPACE_START
+
+ModuleBuilder::ModuleBuilder() = default;
+
+ModuleBuilder::~ModuleBuilder() = default;
+
+void ModuleBuilder::Start(const std::filesystem::path& project_dir, std::size_t jobs)
+{
+    _process.reset();
+    _log.clear();
+    _partial_line.clear();
+
+    _project_dir = project_dir;
+    _jobs        = jobs != 0 ? jobs : std::max(std::thread::hardware_concurrency(), 1u);
+    _start       = Clock::now();
+
+    // A configured project only needs to be built, CMake configures it again by itself if its lists changed.
+    std::error_code ec;
+    if (std::filesystem::exists(GetBuildDir() / "CMakeCache.txt", ec))
+    {
+        _status = BuildStatus::Building;
+        Run({"cmake", "--build", GetBuildDir().string(), "--parallel", std::to_string(_jobs)});
+    }
+    else
+    {
+        _status = BuildStatus::Configuring;
+        Run({"cmake", "-S", _project_dir.string(), "-B", GetBuildDir().string()});
+    }
+}
+
+void ModuleBuilder::Cancel()
+{
+    if (!IsRunning()) return;
+
+    _process.reset();
+    _log.emplace_back("Build cancelled");
+    Finish(BuildStatus::Cancelled);
+}
+
+bool ModuleBuilder::Update()
+{
+    if (!IsRunning() || !_process) return false;
+
+    // The output is taken after checking whether the process exited, so none written before it exited is missed.
+    const bool running = _process->IsRunning();
+    AppendOutput(_process->TakeOutput());
+    if (running) return false;
+
+    if (!_partial_line.empty()) _log.push_back(std::exchange(_partial_line, {}));
+
+    if (const int exit_code = _process->GetExitCode(); exit_code != 0)
+    {
+        _log.push_back(fmt::format("Exited with code {}", exit_code));
+        Finish(BuildStatus::Failed);
+        return true;
+    }
+
+    if (_status == BuildStatus::Configuring)
+    {
+        _status = BuildStatus::Building;
+        Run({"cmake", "--build", GetBuildDir().string(), "--parallel", std::to_string(_jobs)});
+        return !IsRunning();
+    }
+
+    Finish(BuildStatus::Succeeded);
+    return true;
+}
+
+std::string ModuleBuilder::GetStatusText() const
+{
+    const std::chrono::duration<float> running = Clock::now() - _start;
+    switch (_status)
+    {
+        case BuildStatus::Idle:
+            return "Not built";
+        case BuildStatus::Configuring:
+            return fmt::format("Configuring... {:.1f} s", running.count());
+        case BuildStatus::Building:
+            return fmt::format("Building... {:.1f} s", running.count());
+        case BuildStatus::Succeeded:
+            return fmt::format("Built in {:.1f} s", _elapsed.count());
+        case BuildStatus::Failed:
+            return fmt::format("Failed after {:.1f} s", _elapsed.count());
+        case BuildStatus::Cancelled:
+            return "Cancelled";
+    }
+
+    return {};
+}
+
+void ModuleBuilder::Run(std::vector<std::string> args)
+{
+    std::string command = "$";
+    for (const auto& arg : args)
+    {
+        command += " " + arg;
+    }
+    _log.push_back(std::move(command));
+
+    try
+    {
+        _process = std::make_unique<utility::Process>(args);
+    }
+    catch (const std::exception& e)
+    {
+        _process.reset();
+        _log.emplace_back(e.what());
+        Finish(BuildStatus::Failed);
+    }
+}
+
+void ModuleBuilder::Finish(BuildStatus status)
+{
+    _status  = status;
+    _elapsed = Clock::now() - _start;
+
+    SPDLOG_INFO("Build of module project '{0}': {1}", _project_dir.string(), GetStatusText());
+}
+
+void ModuleBuilder::AppendOutput(std::string_view output)
+{
+    for (std::size_t end = output.find('\n'); end != std::string_view::npos; end = output.find('\n'))
+    {
+        _partial_line.append(output.substr(0, end));
+        if (!_partial_line.empty() && _partial_line.back() == '\r') _partial_line.pop_back();
+
+        _log.push_back(std::exchange(_partial_line, {}));
+        output.remove_prefix(end + 1);
+    }
+
+    _partial_line.append(output);
+}
+
+FLOW_UI_NAMESPACE_END
@@ -0,0 +1,123 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+FLOW_UI_NAMESPACE_START
+
+namespace utility
+{
+class Process;
+}
+
+/**
+ * @brief The state of a module build.
+ */
+enum class BuildStatus : std::uint8_t
+{
+    Idle,
+    Configuring,
+    Building,
+    Succeeded,
+    Failed,
+    Cancelled,
+};
+
+/**
+ * @brief Builds module projects with CMake in a child process, collecting its output.
+ */
+class ModuleBuilder
+{
+    using Clock = std::chrono::steady_clock;
+
+  public:
+    ModuleBuilder();
+    ~ModuleBuilder();
+
+    /**
+     * @brief Starts building a module project, cancelling the current build.
+     *
+     * Projects that were configured before are built incrementally, without running the configure step again.
+     *
+     * @param project_dir The directory of the project, which is built into its build directory.
+     * @param jobs The number of parallel build jobs, 0 for one per CPU.
+     */
+    void Start(const std::filesystem::path& project_dir, std::size_t jobs);
+
+    /**
+     * @brief Stops the current build.
+     */
+    void Cancel();
+
+    /**
+     * @brief Collects the output of the current step and starts the next step once it is done, called every frame.
+     * @returns true if the build finished during the call, false otherwise.
+     */
+    bool Update();
+
+    /**
+     * @brief Gets whether a build is configuring or building.
+     * @returns true if a build is running, false otherwise.
+     */
+    bool IsRunning() const noexcept { return _status == BuildStatus::Configuring || _status == BuildStatus::Building; }
+
+    /**
+     * @brief Gets the state of the last build.
+     * @returns The build status.
+     */
+    BuildStatus GetStatus() const noexcept { return _status; }
+
+    /**
+     * @brief Gets a description of the state of the last build, including how long it took.
+     * @returns The status text.
+     */
+    std::string GetStatusText() const;
+
+    /**
+     * @brief Gets the directory of the project that was built last.
+     * @returns The project directory.
+     */
+    const std::filesystem::path& GetProjectDir() const noexcept { return _project_dir; }
+
+    /**
+     * @brief Gets the directory the project is built into.
+     * @returns The build directory.
+     */
+    std::filesystem::path GetBuildDir() const { return _project_dir / "build"; }
+
+    /**
+     * @brief Gets the lines of output of the last build, including the commands that were run.
+     * @returns The output lines.
+     */
+    const std::vector<std::string>& GetLog() const noexcept { return _log; }
+
+  private:
+    void Run(std::vector<std::string> args);
+    void Finish(BuildStatus status);
+    void AppendOutput(std::string_view output);
+
+  private:
+    std::unique_ptr<utility::Process> _process;
+    BuildStatus _status = BuildStatus::Idle;
+    std::filesystem::path _project_dir;
+    std::size_t _jobs = 0;
+
+    std::vector<std::string> _log;
+    std::string _partial_line;
+
+    Clock::time_point _start;
+    std::chrono::duration<float> _elapsed{};
+};
+
+FLOW_UI_NAMESPACE_END
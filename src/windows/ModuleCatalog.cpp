@@ -0,0 +1,208 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include "ModuleCatalog.hpp"
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+FLOW_UI_NAMESPACE_START
+
+using json = nlohmann::json;
+
+namespace
+{
+const std::string manifest_extension = ".flowmod";
+const std::string cache_file_name    = "modules.cache.json";
+constexpr int cache_version          = 2;
+
+struct CacheEntry
+{
+    std::int64_t ModifiedTime = 0;
+    std::uint64_t Hash        = 0;
+    ModuleInfo Info;
+};
+
+using Cache = std::unordered_map<std::string, CacheEntry>;
+
+/**
+ * @brief Hashes a manifest's contents with 64-bit FNV-1a.
+ */
+std::uint64_t HashContents(std::string_view contents) noexcept
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const unsigned char c : contents)
+    {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+Cache LoadCache(const std::filesystem::path& file)
+try
+{
+    std::ifstream fs(file);
+    if (!fs) return {};
+
+    const json cache_json = json::parse(fs);
+    if (cache_json.value("version", 0) != cache_version) return {};
+
+    Cache cache;
+    for (const auto& entry : cache_json.at("modules"))
+    {
+        cache.emplace(entry.at("file").get<std::string>(), CacheEntry{
+                                                                .ModifiedTime = entry.at("mtime").get<std::int64_t>(),
+                                                                .Hash         = entry.at("hash").get<std::uint64_t>(),
+                                                                .Info         = entry.at("info").get<ModuleInfo>(),
+                                                            });
+    }
+
+    return cache;
+}
+catch (const std::exception& e)
+{
+    SPDLOG_WARN("Ignoring module cache '{0}': {1}", file.string(), e.what());
+    return {};
+}
+
+void SaveCache(const std::filesystem::path& file, const std::vector<ModuleManifest>& manifests)
+{
+    json modules_json = json::array();
+    for (const auto& manifest : manifests)
+    {
+        modules_json.push_back({
+            {"file", manifest.File.filename().string()},
+            {"mtime", manifest.ModifiedTime},
+            {"hash", manifest.Hash},
+            {"info", manifest.Info},
+        });
+    }
+
+    std::ofstream fs(file);
+    if (!fs)
+    {
+        SPDLOG_WARN("Could not write module cache '{0}'", file.string());
+        return;
+    }
+
+    fs << json{{"version", cache_version}, {"modules", std::move(modules_json)}}.dump(4);
+}
+
+std::optional<ModuleManifest> ReadManifest(const std::filesystem::path& file, std::int64_t modified_time,
+                                           const CacheEntry* cached)
+try
+{
+    std::ifstream fs(file, std::ios::binary);
+    const std::string contents{std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>()};
+
+    ModuleManifest manifest{.File = file, .ModifiedTime = modified_time, .Hash = HashContents(contents)};
+
+    // A manifest that was touched but not changed does not need to be parsed again.
+    if (cached && cached->Hash == manifest.Hash)
+    {
+        manifest.Info = cached->Info;
+    }
+    else
+    {
+        manifest.Info = json::parse(contents).get<ModuleInfo>();
+    }
+
+    return manifest;
+}
+catch (const std::exception& e)
+{
+    SPDLOG_ERROR("Failed to read module manifest '{0}': {1}", file.string(), e.what());
+    return std::nullopt;
+}
+} // namespace
+
+std::vector<ModuleManifest> ScanModules(const std::filesystem::path& modules_path)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(modules_path, ec)) return {};
+
+    const auto cache_file = modules_path / cache_file_name;
+    const Cache cache     = LoadCache(cache_file);
+
+    struct StaleManifest
+    {
+        std::filesystem::path File;
+        std::int64_t ModifiedTime;
+        const CacheEntry* Cached;
+    };
+
+    std::vector<ModuleManifest> manifests;
+    std::vector<StaleManifest> stale;
+    for (const auto& entry : std::filesystem::directory_iterator(modules_path, ec))
+    {
+        if (entry.path().extension() != manifest_extension) continue;
+
+        const std::int64_t modified_time = entry.last_write_time(ec).time_since_epoch().count();
+        const auto cached                = cache.find(entry.path().filename().string());
+        if (cached != cache.end() && cached->second.ModifiedTime == modified_time)
+        {
+            manifests.push_back({entry.path(), cached->second.Info, modified_time, cached->second.Hash});
+            continue;
+        }
+
+        stale.push_back({entry.path(), modified_time, cached != cache.end() ? &cached->second : nullptr});
+    }
+
+    if (!stale.empty())
+    {
+        std::vector<std::optional<ModuleManifest>> results(stale.size());
+        std::atomic_size_t next = 0;
+
+        const auto read_next = [&] {
+            for (std::size_t i = next++; i < stale.size(); i = next++)
+            {
+                results[i] = ReadManifest(stale[i].File, stale[i].ModifiedTime, stale[i].Cached);
+            }
+        };
+
+        const std::size_t workers = std::min<std::size_t>(stale.size(), std::thread::hardware_concurrency());
+        std::vector<std::future<void>> readers;
+        for (std::size_t i = 1; i < workers; ++i)
+        {
+            readers.push_back(std::async(std::launch::async, read_next));
+        }
+
+        read_next();
+        for (auto& reader : readers)
+        {
+            reader.get();
+        }
+
+        for (auto& result : results)
+        {
+            if (result) manifests.push_back(std::move(*result));
+        }
+    }
+
+    std::sort(manifests.begin(), manifests.end(),
+              [](const auto& a, const auto& b) { return a.File.filename() < b.File.filename(); });
+
+    if (!stale.empty() || manifests.size() != cache.size())
+    {
+        SaveCache(cache_file, manifests);
+    }
+
+    SPDLOG_DEBUG("Found {0} module(s) in '{1}', {2} read from disk", manifests.size(), modules_path.string(),
+                 stale.size());
+
+    return manifests;
+}
+
+FLOW_UI_NAMESPACE_END
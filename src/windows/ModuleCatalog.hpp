@@ -0,0 +1,44 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#pragma once
+
+#include "Core.hpp"
+#include "ModuleInfo.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+FLOW_UI_NAMESPACE_START
+
+/**
+ * @brief The metadata of a module read from its .flowmod manifest, without loading its binary.
+ */
+struct ModuleManifest
+{
+    /// The manifest file.
+    std::filesystem::path File;
+
+    /// The module information from the manifest.
+    ModuleInfo Info;
+
+    /// The modification time of the manifest when it was read.
+    std::int64_t ModifiedTime = 0;
+
+    /// The hash of the manifest's contents.
+    std::uint64_t Hash = 0;
+};
+
+/**
+ * @brief Reads the manifests of every module in a directory.
+ *
+ * Manifests are read in parallel. Parsed metadata is cached in the directory, keyed by modification time and content
+ * hash, so unchanged manifests are not parsed again on the next start.
+ *
+ * @param modules_path The modules directory.
+ * @returns The manifests sorted by file name. Manifests that cannot be read are skipped.
+ */
+std::vector<ModuleManifest> ScanModules(const std::filesystem::path& modules_path);
+
+FLOW_UI_NAMESPACE_END
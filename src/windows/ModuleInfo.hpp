@@ -5,17 +5,30 @@
 #include <nlohmann/json.hpp>
 
 #include <string>
+#include <vector>
 
 FLOW_UI_NAMESPACE_START
 
+struct ModuleNodeInfo
+{
+    std::string Class;
+    std::string Category;
+    std::string Name;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ModuleNodeInfo, Class, Category, Name);
+
 struct ModuleInfo
 {
     std::string Name;
     std::string Version;
     std::string Author;
     std::string Description;
+
+    /// Node classes the module registers. Modules that declare them are only loaded once one of them is used.
+    std::vector<ModuleNodeInfo> Nodes;
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ModuleInfo, Name, Version, Author, Description);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ModuleInfo, Name, Version, Author, Description, Nodes);
 
 FLOW_UI_NAMESPACE_END
@@ -1,18 +1,36 @@
 #include "ModuleManagerWindow.hpp"
 
+#include "Config.hpp"
 #include "FileExplorer.hpp"
+#include "FramePacer.hpp"
 #include "InputField.hpp"
+#include "ModuleBuilder.hpp"
+#include "ModuleCatalog.hpp"
+#include "Table.hpp"
 #include "Text.hpp"
+#include "ViewFactory.hpp"
 #include "Widget.hpp"
 #include "utilities/Conversions.hpp"
+#include "utilities/FileWatcher.hpp"
+#include "utilities/SharedLibrary.hpp"
 
 #include <flow/core/Env.hpp>
 #include <flow/core/Module.hpp>
 #include <imgui.h>
+#include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <set>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 FLOW_UI_NAMESPACE_START
 
@@ -25,29 +43,173 @@ const std::string module_binary_extension = ".dylib";
 const std::string module_binary_extension = ".so";
 #endif
 
+namespace
+{
+constexpr Colour detail_colour{150, 150, 150};
+constexpr Colour error_colour{220, 80, 80};
+
+/**
+ * @brief Gets the files next to a module's manifest that can be its binary.
+ */
+std::vector<std::filesystem::path> GetModuleBinaryCandidates(const std::filesystem::path& manifest)
+{
+    const std::string stem = manifest.stem().string();
+    return {
+        manifest.parent_path() / (stem + module_binary_extension),
+        manifest.parent_path() / ("lib" + stem + module_binary_extension),
+    };
+}
+
+/**
+ * @brief Finds the binary next to a module's manifest.
+ * @returns The binary, or an empty path if there is none.
+ */
+std::filesystem::path FindModuleBinary(const std::filesystem::path& manifest)
+{
+    for (auto& binary : GetModuleBinaryCandidates(manifest))
+    {
+        std::error_code ec;
+        if (std::filesystem::exists(binary, ec)) return binary;
+    }
+
+    return {};
+}
+
+/**
+ * @brief Finds the binary a module project's build produced.
+ * @returns The binary, or an empty path if there is none.
+ */
+std::filesystem::path FindBuiltBinary(const std::filesystem::path& build_dir, const std::filesystem::path& manifest)
+{
+    std::vector<std::filesystem::path> names;
+    for (const auto& candidate : GetModuleBinaryCandidates(manifest))
+    {
+        names.push_back(candidate.filename());
+    }
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(build_dir, ec))
+    {
+        if (std::ranges::find(names, entry.path().filename()) != names.end()) return entry.path();
+    }
+
+    return {};
+}
+
+/**
+ * @brief Copies a file over another through a temporary file, so the watcher never sees a partly written file.
+ */
+void ReplaceFile(const std::filesystem::path& from, const std::filesystem::path& to)
+{
+    auto temporary = to;
+    temporary += ".tmp";
+
+    std::filesystem::copy_file(from, temporary, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::rename(temporary, to);
+}
+
+/// Directory next to the installed modules that holds the copies the modules are loaded from.
+const std::string shadow_directory_name = ".shadow";
+
+std::atomic_uint64_t shadow_generation = 0;
+
+/**
+ * @brief Gets the path of a new shadow copy of a module's manifest.
+ *
+ * Every load maps a copy of the module in a directory of its own. The dynamic loader can keep a module mapped after it
+ * is closed, e.g. when it has unique symbols, and would return the old code for the same path. Windows also locks
+ * loaded binaries, which could then not be replaced by a new build.
+ */
+std::filesystem::path MakeShadowManifest(const std::filesystem::path& manifest)
+{
+    const std::string directory = fmt::format("{0}.{1}", manifest.stem().string(), ++shadow_generation);
+    return manifest.parent_path() / shadow_directory_name / directory / manifest.filename();
+}
+
+/**
+ * @brief Copies a module's manifest and binary to a shadow copy, keeping their names.
+ */
+void CreateShadowCopy(const std::filesystem::path& manifest, const std::filesystem::path& shadow)
+{
+    std::filesystem::create_directories(shadow.parent_path());
+    std::filesystem::copy_file(manifest, shadow, std::filesystem::copy_options::overwrite_existing);
+
+    if (const auto binary = FindModuleBinary(manifest); !binary.empty())
+    {
+        std::filesystem::copy_file(binary, shadow.parent_path() / binary.filename(),
+                                   std::filesystem::copy_options::overwrite_existing);
+    }
+}
+
+/**
+ * @brief Removes a shadow copy.
+ * @returns true if it was removed, false if it is still in use.
+ */
+bool RemoveShadowCopy(const std::filesystem::path& shadow)
+{
+    std::error_code ec;
+    std::filesystem::remove_all(shadow.parent_path(), ec);
+    return !ec;
+}
+} // namespace
+
+enum class ModuleState : std::uint8_t
+{
+    Unloaded,
+    Loading,
+    Loaded,
+    Unloading,
+    Failed,
+};
+
 class ModuleView : public Widget
 {
+    using Clock   = std::chrono::steady_clock;
+    using Library = std::unique_ptr<utility::SharedLibrary>;
+
   public:
+    /**
+     * @brief Lists a module and starts loading it in the background.
+     */
     ModuleView(const std::filesystem::path& name, std::shared_ptr<Env> env)
-        : _binary_path(name), _enabled(name.filename().replace_extension("").string(), true)
+        : ModuleView(name, ModuleInfo{.Name = name.stem().string()}, std::move(env))
     {
-        _module = std::make_shared<Module>(_binary_path, env->GetFactory());
+        Load();
     }
 
-    virtual void operator()() noexcept
+    /**
+     * @brief Lists a module from its manifest and declares its nodes, the module is loaded once one of them is used.
+     */
+    ModuleView(const std::filesystem::path& name, ModuleInfo info, std::shared_ptr<Env> env)
+        : _binary_path(name), _info(std::move(info)), _env(std::move(env)),
+          _enabled(name.filename().replace_extension("").string(), true)
     {
-        const std::string& name    = _module->GetName();
-        const std::string& version = "Version: " + _module->GetVersion();
-        const std::string& author  = _module->GetAuthor();
+        _factory = std::dynamic_pointer_cast<ViewFactory>(_env->GetFactory());
+
+        _name_text.SetFontSize(20.f);
+        _version_text.SetFontSize(20.f).SetColour(detail_colour);
+        _author_text.SetFontSize(18.f).SetColour(detail_colour);
+        _state_text.SetFontSize(16.f).SetColour(detail_colour);
 
+        DeclareNodes(true);
+        UpdateInfo();
+    }
+
+    virtual void operator()() noexcept
+    {
         ImGui::TableNextColumn();
 
+        ImGui::BeginDisabled(IsBusy());
         _enabled();
+        ImGui::EndDisabled();
 
         ImGui::TableNextColumn();
 
-        ImGui::BeginHorizontal(("module_" + name).c_str());
-        widgets::Text{name}.SetFontSize(20.f)();
+        ImGui::BeginHorizontal(_id.c_str());
+        _name_text();
+
+        const std::string& version = _version_text.GetText();
+        const std::string& author  = _author_text.GetText();
 
         auto pos_x = (ImGui::GetCursorPosX() + ImGui::GetColumnWidth() -
                       ImGui::CalcTextSize(author.length() > version.length() ? author.c_str() : version.c_str()).x +
@@ -59,36 +221,626 @@ class ModuleView : public Widget
         }
 
         ImGui::BeginVertical("version/author");
-        constexpr Colour version_author_colour{150, 150, 150};
-        widgets::Text{version}.SetFontSize(20.f).SetColour(version_author_colour)();
-        widgets::Text{author}.SetFontSize(18.f).SetColour(version_author_colour)();
+        _version_text();
+        _author_text();
+        _state_text();
+        if (_state == ModuleState::Failed && ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip("%s", _error.c_str());
+        }
         ImGui::EndVertical();
         ImGui::EndHorizontal();
 
+        // Keep the elapsed time of a running job ticking.
+        if (IsBusy()) UpdateInfo();
+
         if (auto data = _enabled.GetData())
         {
+            DeclareNodes(_enabled.GetValue());
             if (_enabled.GetValue())
             {
-                _module->Load(_binary_path);
+                Load();
             }
             else
+            {
+                Unload();
+            }
+        }
+    }
+
+    /**
+     * @brief Starts loading the module in the background if it is enabled and not loaded yet.
+     *
+     * The binary is mapped by the background job, the module registers its nodes once Update commits it.
+     */
+    void Load()
+    {
+        if (!_enabled.GetValue() || _state == ModuleState::Loaded || IsBusy()) return;
+
+        if (!_shadow_path.empty()) _stale_shadows.push_back(_shadow_path);
+
+        _state       = ModuleState::Loading;
+        _job_start   = Clock::now();
+        _shadow_path = MakeShadowManifest(_binary_path);
+        _job         = std::async(std::launch::async, [manifest = _binary_path, shadow = _shadow_path] {
+            CreateShadowCopy(manifest, shadow);
+            return std::make_unique<utility::SharedLibrary>(FindModuleBinary(shadow));
+        });
+
+        UpdateInfo();
+    }
+
+    /**
+     * @brief Loads the module and commits it straight away, for nodes that are needed before the next frame.
+     */
+    void LoadNow()
+    {
+        Load();
+        if (_state != ModuleState::Loading) return;
+
+        _job.wait();
+        CommitLoad();
+    }
+
+    /**
+     * @brief Starts unloading the module, its nodes are unregistered once Update commits it.
+     */
+    void Unload()
+    {
+        if (_state == ModuleState::Failed)
+        {
+            _state = ModuleState::Unloaded;
+            UpdateInfo();
+        }
+
+        if (_state != ModuleState::Loaded) return;
+
+        _state     = ModuleState::Unloading;
+        _job_start = Clock::now();
+        UpdateInfo();
+    }
+
+    /**
+     * @brief Commits a load or unload that is ready, must be called on the UI thread between frames.
+     * @returns true if nodes were registered or unregistered with the factory, false otherwise.
+     */
+    bool Update()
+    {
+        if (_state == ModuleState::Loading && IsJobDone())
+        {
+            CommitLoad();
+            return true;
+        }
+
+        if (_state != ModuleState::Unloading) return false;
+
+        if (!_job.valid())
+        {
+            CommitUnload();
+            return true;
+        }
+
+        if (IsJobDone())
+        {
+            _job.get();
+            _elapsed = Clock::now() - _job_start;
+            _state   = ModuleState::Unloaded;
+            RemoveStaleShadows();
+            UpdateInfo();
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Unloads and loads the module again straight away, e.g. after its binary was rebuilt.
+     *
+     * @param on_reload The event run with the node classes the module registered, which has to call the reload
+     *                  function it is given.
+     */
+    void Reload(const ModuleManagerWindow::ReloadEvent& on_reload)
+    {
+        if (_state != ModuleState::Loaded) return;
+
+        auto class_names = _classes;
+        for (const auto& node : _info.Nodes)
+        {
+            class_names.insert(node.Class);
+        }
+
+        // The new build is copied before anything is unloaded, so a failed copy leaves the module running.
+        auto previous_shadow = _shadow_path;
+        auto shadow          = MakeShadowManifest(_binary_path);
+        try
+        {
+            CreateShadowCopy(_binary_path, shadow);
+        }
+        catch (const std::exception& e)
+        {
+            SPDLOG_ERROR("Failed to copy module '{0}' for reloading: {1}", _info.Name, e.what());
+            RemoveShadowCopy(shadow);
+            return;
+        }
+
+        _job_start = Clock::now();
+        on_reload(class_names, [this, &shadow] {
+            try
             {
                 _module->Unload();
+                _shadow_path = shadow;
+                LoadModule();
             }
+            catch (const std::exception& e)
+            {
+                SPDLOG_ERROR("Failed to reload module '{0}': {1}", _info.Name, e.what());
+                _error = e.what();
+                _state = ModuleState::Failed;
+            }
+        });
+
+        _elapsed = Clock::now() - _job_start;
+        if (_factory) _factory->GetTypeRegistry().InvalidateCompatibility();
+
+        if (_state == ModuleState::Loaded)
+        {
+            SPDLOG_INFO("Reloaded module '{0}' in {1:.1f} ms", _info.Name, _elapsed.count());
+        }
+
+        // The copy that is no longer loaded is removed, which is the new one if the reload did not happen.
+        _stale_shadows.push_back(_shadow_path == previous_shadow ? std::move(shadow) : std::move(previous_shadow));
+        RemoveStaleShadows();
+        UpdateInfo();
+    }
+
+    /**
+     * @brief Gets the files that make up the module, which hot reload watches.
+     * @returns The manifest and the files that can be the module's binary.
+     */
+    std::vector<std::filesystem::path> GetFiles() const
+    {
+        auto files = GetModuleBinaryCandidates(_binary_path);
+        files.push_back(_binary_path);
+        return files;
+    }
+
+    bool IsLoading() const noexcept { return _state == ModuleState::Loading; }
+    bool IsBusy() const noexcept { return _state == ModuleState::Loading || _state == ModuleState::Unloading; }
+
+  private:
+    bool IsJobDone() const { return _job.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+    void CommitLoad()
+    {
+        // Released once the module holds its own reference to the binary.
+        Library library;
+
+        try
+        {
+            library = _job.get();
+            LoadModule();
+        }
+        catch (const std::exception& e)
+        {
+            SPDLOG_ERROR("Failed to load module '{0}': {1}", _info.Name, e.what());
+            _error = e.what();
+            _state = ModuleState::Failed;
+            _stale_shadows.push_back(std::exchange(_shadow_path, {}));
+        }
+
+        _elapsed = Clock::now() - _job_start;
+
+        // Modules can register conversions between types that were already checked.
+        if (_factory) _factory->GetTypeRegistry().InvalidateCompatibility();
+
+        UpdateInfo();
+    }
+
+    void LoadModule()
+    {
+        // The classes the module registers are recorded so that hot reload knows which nodes to rebuild.
+        const auto& factory = _env->GetFactory();
+        factory->OnNodeClassRegistered.Bind("RecordModuleClasses",
+                                            [this](std::string_view class_name) { _classes.emplace(class_name); });
+
+        _classes.clear();
+        try
+        {
+            if (_module)
+            {
+                _module->Load(_shadow_path);
+            }
+            else
+            {
+                _module = std::make_shared<Module>(_shadow_path, factory);
+            }
+        }
+        catch (...)
+        {
+            factory->OnNodeClassRegistered.Unbind("RecordModuleClasses");
+            throw;
+        }
+
+        factory->OnNodeClassRegistered.Unbind("RecordModuleClasses");
+        _state = ModuleState::Loaded;
+
+        // A rebuilt binary can change its details, so the manifest's copy is kept in step with it.
+        _info.Name    = _module->GetName();
+        _info.Version = _module->GetVersion();
+        _info.Author  = _module->GetAuthor();
+    }
+
+    void CommitUnload()
+    {
+        // Holding a reference keeps the binary mapped while the module unregisters its nodes, so unmapping it and
+        // running its static destructors happens in the background job instead.
+        auto library = std::make_unique<utility::SharedLibrary>(FindModuleBinary(_shadow_path));
+
+        try
+        {
+            _module->Unload();
+        }
+        catch (const std::exception& e)
+        {
+            SPDLOG_ERROR("Failed to unload module '{0}': {1}", _info.Name, e.what());
+            _error = e.what();
+            _state = ModuleState::Failed;
+        }
+
+        if (_factory) _factory->GetTypeRegistry().InvalidateCompatibility();
+
+        // The shadow copy is removed once the background job has unmapped it.
+        _stale_shadows.push_back(std::exchange(_shadow_path, {}));
+
+        _job = std::async(std::launch::async, [library = std::move(library)]() mutable {
+            library.reset();
+            return Library{};
+        });
+
+        UpdateInfo();
+    }
+
+    void RemoveStaleShadows()
+    {
+        // Copies that are still mapped, e.g. on Windows while the loader holds them, are tried again later.
+        std::erase_if(_stale_shadows, [](const auto& shadow) { return shadow.empty() || RemoveShadowCopy(shadow); });
+    }
+
+    void DeclareNodes(bool declare)
+    {
+        if (!_factory) return;
+
+        for (const auto& node : _info.Nodes)
+        {
+            if (declare)
+            {
+                _factory->DeclareNodeClass(node.Class, node.Category, node.Name);
+            }
+            else
+            {
+                _factory->RemoveDeclaredNodeClass(node.Class);
+            }
+        }
+    }
+
+    void UpdateInfo()
+    {
+        const std::string& name = _module ? _module->GetName() : _info.Name;
+
+        _id = "module_" + name;
+        _name_text.SetText(name);
+        _version_text.SetText("Version: " + (_module ? _module->GetVersion() : _info.Version));
+        _author_text.SetText(_module ? _module->GetAuthor() : _info.Author);
+        _state_text.SetColour(_state == ModuleState::Failed ? error_colour : detail_colour);
+
+        const std::chrono::duration<float> running = Clock::now() - _job_start;
+        switch (_state)
+        {
+            case ModuleState::Loading:
+                _state_text.SetText(fmt::format("Loading... {:.1f} s", running.count()));
+                break;
+            case ModuleState::Loaded:
+                _state_text.SetText(fmt::format("Loaded in {:.1f} ms", _elapsed.count()));
+                break;
+            case ModuleState::Unloading:
+                _state_text.SetText(fmt::format("Unloading... {:.1f} s", running.count()));
+                break;
+            case ModuleState::Failed:
+                _state_text.SetText(fmt::format("Failed after {:.1f} ms", _elapsed.count()));
+                break;
+            case ModuleState::Unloaded:
+                if (_enabled.GetValue())
+                {
+                    _state_text.SetText("Loads on first use");
+                }
+                else if (_module)
+                {
+                    _state_text.SetText(fmt::format("Unloaded in {:.1f} ms", _elapsed.count()));
+                }
+                else
+                {
+                    _state_text.SetText("Not loaded");
+                }
+                break;
         }
     }
 
   private:
     std::filesystem::path _binary_path;
+    std::filesystem::path _shadow_path;
+    std::vector<std::filesystem::path> _stale_shadows;
+    ModuleInfo _info;
+    std::shared_ptr<Env> _env;
     std::shared_ptr<Module> _module;
+    std::shared_ptr<ViewFactory> _factory;
     widgets::Input<bool> _enabled;
+
+    ModuleState _state = ModuleState::Unloaded;
+    std::future<Library> _job;
+    Clock::time_point _job_start;
+    std::chrono::duration<float, std::milli> _elapsed{};
+    std::string _error;
+    std::unordered_set<std::string> _classes;
+
+    std::string _id;
+    widgets::Text _name_text{""};
+    widgets::Text _version_text{""};
+    widgets::Text _author_text{""};
+    widgets::Text _state_text{""};
 };
 
 ModuleManagerWindow::ModuleManagerWindow(std::shared_ptr<Env> env, const std::filesystem::path& modules_path)
     : Window("Module Manager"), _env(std::move(env)), _modules_path(modules_path),
-      _new_module_window(std::make_unique<NewModuleWindow>())
+      _new_module_window(std::make_unique<NewModuleWindow>()), _builder(std::make_unique<ModuleBuilder>()),
+      _module_table(std::make_unique<widgets::Table>(_name + "##list", 2))
 {
     std::filesystem::create_directory(_modules_path);
+
+    // Shadow copies left behind by an earlier run are no longer loaded.
+    std::error_code ec;
+    std::filesystem::remove_all(_modules_path / shadow_directory_name, ec);
+
+    // Every module row has the same layout, so only the visible ones are drawn.
+    _module_table->SetBorders(widgets::Table::Borders::Outer);
+    _module_table->SetCellPadding(10.f, 10.f);
+    _module_table->SetColumnSizing(0, widgets::Table::ColumnSizing::Fixed);
+    _module_table->SetColumnSizing(1, widgets::Table::ColumnSizing::Stretch);
+    _module_table->SetRowProvider(0, [this](std::size_t row) { (*_module_rows[row])(); });
+
+    _scan = std::async(std::launch::async, ScanModules, _modules_path);
+
+    if (auto factory = std::dynamic_pointer_cast<ViewFactory>(_env->GetFactory()))
+    {
+        factory->OnNodeClassRequired = [this](const std::string& class_name) { LoadModuleOf(class_name); };
+    }
+}
+
+ModuleManagerWindow::~ModuleManagerWindow()
+{
+    if (auto factory = std::dynamic_pointer_cast<ViewFactory>(_env->GetFactory()))
+    {
+        factory->OnNodeClassRequired = [](const auto&) {};
+    }
+}
+
+void ModuleManagerWindow::Update()
+{
+    if (_scan.valid() && _scan.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        FinishScan();
+    }
+
+    if (_watcher)
+    {
+        // A build usually replaces both the manifest and the binary, which only reloads the module once.
+        std::set<std::string> changed_modules;
+        for (const auto& file : _watcher->Poll())
+        {
+            if (auto module = _watched_files.find(file.string()); module != _watched_files.end())
+            {
+                changed_modules.insert(module->second);
+            }
+        }
+
+        for (const auto& key : changed_modules)
+        {
+            _widgets.at(key)->Reload(OnModuleReload);
+        }
+    }
+
+    if (_builder->Update() && _builder->GetStatus() == BuildStatus::Succeeded)
+    {
+        InstallBuiltModule();
+    }
+
+    // Binaries are mapped in the background, but modules register their nodes with the shared factory that the UI
+    // reads every frame. Registration is committed here, between frames, one module per frame.
+    bool committed = false;
+    bool busy      = _scan.valid() || _builder->IsRunning();
+    for (const auto& [_, view] : _widgets)
+    {
+        if (!committed) committed = view->Update();
+        busy |= view->IsBusy();
+    }
+
+    // Keep drawing at full rate until every job is done.
+    if (busy) GetFramePacer().Wake();
+}
+
+void ModuleManagerWindow::FinishScan()
+{
+    if (!_scan.valid()) return;
+
+    for (auto& manifest : _scan.get())
+    {
+        const std::string key = manifest.File.string();
+        if (_widgets.contains(key)) continue;
+
+        // Modules that do not declare their nodes have to be loaded to find out what they provide.
+        if (manifest.Info.Nodes.empty())
+        {
+            AddModule(key, std::make_shared<ModuleView>(manifest.File, _env));
+            continue;
+        }
+
+        for (const auto& node : manifest.Info.Nodes)
+        {
+            _class_modules.emplace(node.Class, key);
+        }
+
+        AddModule(key, std::make_shared<ModuleView>(manifest.File, std::move(manifest.Info), _env));
+    }
+}
+
+void ModuleManagerWindow::SetHotReload(bool enabled)
+{
+    _watched_files.clear();
+    _watcher.reset();
+    if (!enabled) return;
+
+    _watcher = std::make_unique<utility::FileWatcher>(std::chrono::duration<float>(GetConfig().ModuleReloadDelay));
+    for (const auto& [key, _] : _widgets)
+    {
+        WatchModule(key);
+    }
+}
+
+void ModuleManagerWindow::AddModule(const std::string& key, std::shared_ptr<ModuleView> view)
+{
+    _widgets[key] = std::move(view);
+    _module_rows.clear();
+
+    WatchModule(key);
+}
+
+void ModuleManagerWindow::WatchModule(const std::string& key)
+{
+    if (!_watcher) return;
+
+    for (const auto& file : _widgets.at(key)->GetFiles())
+    {
+        _watcher->Watch(file);
+        _watched_files[file.string()] = key;
+    }
+}
+
+void ModuleManagerWindow::LoadModuleOf(const std::string& class_name)
+{
+    // A flow opened at startup can need its nodes before the scan is picked up by Update.
+    FinishScan();
+
+    if (auto module = _class_modules.find(class_name); module != _class_modules.end())
+    {
+        _widgets.at(module->second)->LoadNow();
+        return;
+    }
+
+    // The class can only come from a module that does not declare its nodes, so the ones still loading finish now.
+    for (const auto& [_, view] : _widgets)
+    {
+        if (view->IsLoading()) view->LoadNow();
+    }
+}
+
+void ModuleManagerWindow::StartBuild(const std::filesystem::path& project_dir)
+{
+    _builder->Start(project_dir, GetConfig().ModuleBuildJobs);
+    GetFramePacer().Wake();
+}
+
+void ModuleManagerWindow::InstallBuiltModule()
+try
+{
+    const auto& project_dir = _builder->GetProjectDir();
+
+    std::filesystem::path manifest;
+    for (const auto& entry : std::filesystem::directory_iterator(project_dir))
+    {
+        if (entry.path().extension() == "." + module_file_extension)
+        {
+            manifest = entry.path();
+            break;
+        }
+    }
+
+    if (manifest.empty()) throw std::runtime_error("The project has no module manifest");
+
+    const auto binary = FindBuiltBinary(_builder->GetBuildDir(), manifest);
+    if (binary.empty()) throw std::runtime_error("The build did not produce a module binary");
+
+    const auto installed = _modules_path / manifest.filename();
+    ReplaceFile(manifest, installed);
+    ReplaceFile(binary, _modules_path / binary.filename());
+
+    const std::string key = installed.string();
+    if (auto view = _widgets.find(key); view != _widgets.end())
+    {
+        // Watched modules are reloaded by the watcher once the copied files settle.
+        if (!_watcher) view->second->Reload(OnModuleReload);
+        view->second->Load();
+    }
+    else
+    {
+        AddModule(key, std::make_shared<ModuleView>(installed, _env));
+    }
+
+    SPDLOG_INFO("Installed module '{0}' to '{1}'", manifest.stem().string(), _modules_path.string());
+}
+catch (const std::exception& e)
+{
+    SPDLOG_ERROR("Failed to install the module built in '{0}': {1}", _builder->GetProjectDir().string(), e.what());
+}
+
+void ModuleManagerWindow::DrawBuildLog()
+{
+    const std::string header = fmt::format("Build {0}: {1}###BuildLog", _builder->GetProjectDir().filename().string(),
+                                           _builder->GetStatusText());
+    if (!ImGui::CollapsingHeader(header.c_str(), ImGuiTreeNodeFlags_DefaultOpen)) return;
+
+    ImGui::BeginHorizontal("BuildButtons");
+    if (_builder->IsRunning())
+    {
+        if (ImGui::Button("Cancel")) _builder->Cancel();
+    }
+    else if (ImGui::Button("Rebuild"))
+    {
+        StartBuild(_builder->GetProjectDir());
+    }
+
+    auto& config = GetConfig();
+    int jobs     = static_cast<int>(config.ModuleBuildJobs);
+    ImGui::SetNextItemWidth(100.f);
+    if (ImGui::InputInt("Jobs", &jobs))
+    {
+        config.ModuleBuildJobs = static_cast<std::size_t>(std::max(jobs, 0));
+    }
+
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::SetTooltip("Parallel build jobs, 0 uses one per CPU");
+    }
+    ImGui::EndHorizontal();
+
+    const auto& log    = _builder->GetLog();
+    const float height = ImGui::GetTextLineHeightWithSpacing() * 12.f;
+    if (ImGui::BeginChild("BuildOutput", ImVec2(0.f, height), true, ImGuiWindowFlags_HorizontalScrollbar))
+    {
+        // Follow new output unless the log was scrolled up.
+        const bool follow = ImGui::GetScrollY() >= ImGui::GetScrollMaxY();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(log.size()));
+        while (clipper.Step())
+        {
+            for (int line = clipper.DisplayStart; line < clipper.DisplayEnd; ++line)
+            {
+                ImGui::TextUnformatted(log[line].c_str());
+            }
+        }
+        clipper.End();
+
+        if (follow) ImGui::SetScrollHereY(1.f);
+    }
+    ImGui::EndChild();
 }
 
 void ModuleManagerWindow::Draw()
@@ -106,14 +858,35 @@ void ModuleManagerWindow::Draw()
     {
         std::filesystem::create_directory(_modules_path);
 
+    // Shadow copies left behind by an earlier run are no longer loaded.
+    std::error_code ec;
+    std::filesystem::remove_all(_modules_path / shadow_directory_name, ec);
+
         const auto filename =
             FileExplorer::Load(FileExplorer::GetDocumentsPath(), "Flow Module (flowmod)", module_file_extension);
 
         {
-            _widgets[filename.string()] = std::make_shared<ModuleView>(filename, _env);
+            AddModule(filename.string(), std::make_shared<ModuleView>(filename, _env));
         }
     }
 
+    if (ImGui::Button("Build Module"))
+    {
+        const auto manifest = FileExplorer::Load(FileExplorer::GetDocumentsPath(), "Flow Module Project (flowmod)",
+                                                 module_file_extension);
+        if (!manifest.empty()) StartBuild(manifest.parent_path());
+    }
+
+    if (ImGui::Checkbox("Hot Reload", &_hot_reload))
+    {
+        SetHotReload(_hot_reload);
+    }
+
+    if (ImGui::IsItemHovered())
+    {
+        ImGui::SetTooltip("Reload modules when their files change, rebuilding their nodes in open flows");
+    }
+
     ImGui::PopStyleColor();
     ImGui::PopStyleVar();
 
@@ -124,6 +897,7 @@ void ModuleManagerWindow::Draw()
     {
         if (_new_module_window->DrawAndCreate())
         {
+            StartBuild(_new_module_window->GetProjectDir());
             _new_module_window.reset(new NewModuleWindow());
         }
 
@@ -131,6 +905,21 @@ void ModuleManagerWindow::Draw()
     }
     ImGui::EndHorizontal();
 
+    if (_scan.valid())
+    {
+        ImGui::TextDisabled("Scanning modules...");
+    }
+    else if (const auto loading = std::ranges::count_if(_widgets, [](const auto& w) { return w.second->IsLoading(); });
+             loading > 0)
+    {
+        ImGui::TextDisabled("Loading %zu module(s)...", static_cast<std::size_t>(loading));
+    }
+
+    if (_builder->GetStatus() != BuildStatus::Idle)
+    {
+        DrawBuildLog();
+    }
+
     if (_widgets.empty())
     {
         return Window::Draw();
@@ -142,19 +931,20 @@ void ModuleManagerWindow::Draw()
     ImGui::PushStyleVar(ImGuiStyleVar_IndentSpacing, 10.f);
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(1.f, 1.f));
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(10.f, 10.f));
-    ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(10.f, 10.f));
-    ImGui::BeginTable((_name + "##list").c_str(), 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter);
 
-    ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed);
-    ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthStretch);
-
-    for (const auto& [_, w] : _widgets)
+    if (_module_rows.size() != _widgets.size())
     {
-        (*w)();
+        _module_rows.clear();
+        for (const auto& [_, view] : _widgets)
+        {
+            _module_rows.push_back(view.get());
+        }
+
+        _module_table->SetRowCount(_module_rows.size());
     }
 
-    ImGui::EndTable();
-    ImGui::PopStyleVar(5);
+    (*_module_table)();
+    ImGui::PopStyleVar(4);
 
     ImGui::EndChild();
 }
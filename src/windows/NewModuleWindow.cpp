@@ -27,7 +27,7 @@ std::string replace_all(std::string str, const std::string& from, const std::str
 }
 
 void GenerateProjectFiles(std::filesystem::path project_dir, const ModuleInfo& info,
-                          const std::vector<std::string>& dependencies)
+                          const std::vector<std::string>& dependencies, bool benchmark)
 {
     if (std::filesystem::exists(project_dir))
     {
@@ -68,6 +68,13 @@ void GenerateProjectFiles(std::filesystem::path project_dir, const ModuleInfo& i
                                                               return a + replace_all(find_lib_str, "{{lib}}", b) + "\n";
                                                           });
 
+        const std::string benchmark_str = "option(BUILD_BENCHMARK \"Build the node benchmark\" ON)\n"s +
+                                          "if(BUILD_BENCHMARK)\n"s +
+                                          "    set(BENCHMARK_TARGET ${PROJECT_NAME}_benchmark)\n"s +
+                                          "    add_executable(${BENCHMARK_TARGET} bench/benchmark.cpp)\n"s +
+                                          "    target_link_libraries(${BENCHMARK_TARGET} PRIVATE ${PROJECT_NAME})\n"s +
+                                          "endif()"s;
+
         std::ifstream cmake_lists_template_fs(FileExplorer::GetExecutablePath() / "templates" /
                                               "ModuleCMakeLists.txt.in");
         std::stringstream buffer;
@@ -80,11 +87,29 @@ void GenerateProjectFiles(std::filesystem::path project_dir, const ModuleInfo& i
         cmake_lists_template = replace_all(cmake_lists_template, "{{find_libs}}", find_libs_str);
         cmake_lists_template = replace_all(cmake_lists_template, "{{dependencies}}", dependencies_str);
         cmake_lists_template = replace_all(cmake_lists_template, "{{export}}", export_str);
+        cmake_lists_template = replace_all(cmake_lists_template, "{{benchmark}}", benchmark ? benchmark_str : "");
 
         std::ofstream cmake_lists_fs(project_dir / "CMakeLists.txt");
         cmake_lists_fs << cmake_lists_template;
     }
 
+    // include/<namespace>/Module.hpp
+    {
+        std::filesystem::create_directories(project_dir / "include" / namespace_str);
+
+        std::ifstream module_header_template_fs(FileExplorer::GetExecutablePath() / "templates" / "module.hpp.in");
+        std::stringstream buffer;
+        buffer << module_header_template_fs.rdbuf();
+
+        std::string module_header_template = buffer.str();
+        module_header_template             = replace_all(module_header_template, "{{namespace}}", namespace_str);
+        module_header_template             = replace_all(module_header_template, "{{export}}", export_str);
+        module_header_template             = replace_all(module_header_template, "{{api}}", api_str);
+
+        std::ofstream module_header_fs(project_dir / "include" / namespace_str / "Module.hpp");
+        module_header_fs << module_header_template;
+    }
+
     // register.cpp
     {
         std::ifstream register_source_template_fs(FileExplorer::GetExecutablePath() / "templates" / "register.cpp.in");
@@ -100,35 +125,27 @@ void GenerateProjectFiles(std::filesystem::path project_dir, const ModuleInfo& i
         register_source_fs << register_source_template;
     }
 
-    // module.flowmod
+    // bench/benchmark.cpp
+    if (benchmark)
     {
-        std::ofstream module_file_fs(project_dir / (info.Name + ".flowmod"));
-        module_file_fs << json(info).dump(4);
-    }
-}
+        std::filesystem::create_directories(project_dir / "bench");
 
-bool BuildProject(std::filesystem::path project_dir)
-{
-    const std::filesystem::path build_dir = project_dir / "build";
-
-    std::string configure_cmd = "cmake -S {{project_dir}} -B {{build_dir}}";
-    configure_cmd             = replace_all(configure_cmd, "{{project_dir}}", project_dir.string());
-    configure_cmd             = replace_all(configure_cmd, "{{build_dir}}", build_dir.string());
+        std::ifstream benchmark_template_fs(FileExplorer::GetExecutablePath() / "templates" / "benchmark.cpp.in");
+        std::stringstream buffer;
+        buffer << benchmark_template_fs.rdbuf();
 
-    std::string build_cmd = "cmake --build {{build_dir}} -j";
-    build_cmd             = replace_all(build_cmd, "{{build_dir}}", build_dir.string());
+        std::string benchmark_source_template = buffer.str();
+        benchmark_source_template             = replace_all(benchmark_source_template, "{{namespace}}", namespace_str);
 
-    if (std::system(configure_cmd.c_str()))
-    {
-        return false;
+        std::ofstream benchmark_source_fs(project_dir / "bench" / "benchmark.cpp");
+        benchmark_source_fs << benchmark_source_template;
     }
 
-    if (std::system(build_cmd.c_str()))
+    // module.flowmod
     {
-        return false;
+        std::ofstream module_file_fs(project_dir / (info.Name + ".flowmod"));
+        module_file_fs << json(info).dump(4);
     }
-
-    return true;
 }
 
 NewModuleWindow::NewModuleWindow() : Window(Name)
@@ -138,6 +155,7 @@ NewModuleWindow::NewModuleWindow() : Window(Name)
     author_input      = std::make_shared<widgets::Input<std::string>>("author", "");
     description_input = std::make_shared<widgets::Input<std::string>>("description", "");
     dependencies      = std::make_shared<widgets::Table>("dependencies", 2);
+    benchmark_input   = std::make_shared<widgets::Input<bool>>("benchmark", true);
 
     auto flow_core_dep = std::make_shared<widgets::Input<bool>>("flow-core", true);
     dependencies->AddEntry(flow_core_dep);
@@ -155,6 +173,7 @@ void NewModuleWindow::Clear()
     author_input.reset(new widgets::Input<std::string>("author", ""));
     description_input.reset(new widgets::Input<std::string>("description", ""));
     dependencies.reset(new widgets::Table("dependencies", 2));
+    benchmark_input.reset(new widgets::Input<bool>("benchmark", true));
 
     auto flow_core_dep = std::make_shared<widgets::Input<bool>>("flow-core", true);
     dependencies->AddEntry(flow_core_dep);
@@ -179,6 +198,8 @@ try
     new_module_form.AddEntry(description_input);
     new_module_form.AddEntry(std::make_shared<widgets::Text>("Dependencies"));
     new_module_form.AddEntry(dependencies);
+    new_module_form.AddEntry(std::make_shared<widgets::Text>("Benchmark"));
+    new_module_form.AddEntry(benchmark_input);
 
     new_module_form();
 
@@ -189,8 +210,8 @@ try
     {
         ImGui::CloseCurrentPopup();
 
-        const auto& name        = name_input->GetValue();
-        const auto& project_dir = FileExplorer::GetDocumentsPath() / name;
+        const auto& name = name_input->GetValue();
+        project_dir      = FileExplorer::GetDocumentsPath() / name;
 
         const auto& flow_core_dep = std::static_pointer_cast<widgets::Input<bool>>(dependencies->GetEntry(0));
         const auto& flow_ui_dep   = std::static_pointer_cast<widgets::Input<bool>>(dependencies->GetEntry(2));
@@ -213,9 +234,9 @@ try
                                  .Author      = author_input->GetValue(),
                                  .Description = description_input->GetValue(),
                              },
-                             chosen_deps);
+                             chosen_deps, benchmark_input->GetValue());
 
-        created = BuildProject(project_dir);
+        created = true;
     }
 
     ImGui::SetItemDefaultFocus();
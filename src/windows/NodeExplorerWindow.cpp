@@ -44,61 +44,32 @@ void NodeExplorerWindow::Draw()
 
     ImGui::EndHorizontal();
 
-    auto factory = _env->GetFactory();
-
-    auto registered_nodes = factory->GetCategories();
-
-    if (!node_lookup.empty())
-    {
-        auto partial_match_func = [&](const auto& entry) -> bool {
-            auto [_, class_name]     = entry;
-            std::string display_name = factory->GetFriendlyName(class_name);
-            std::string filter       = node_lookup;
-
-            const auto& to_lower = [](unsigned char c) { return static_cast<unsigned char>(std::tolower(c)); };
-            std::transform(filter.begin(), filter.end(), filter.begin(), to_lower);
-            std::transform(class_name.begin(), class_name.end(), class_name.begin(), to_lower);
-            std::transform(display_name.begin(), display_name.end(), display_name.begin(), to_lower);
-
-            return std::string_view(display_name).find(filter) == std::string_view::npos &&
-                   std::string_view(class_name).find(filter) == std::string_view::npos;
-        };
-
-        std::erase_if(registered_nodes, partial_match_func);
-    }
+    const auto matches = _search.Filter(*_env->GetFactory(), node_lookup);
 
     if (ImGui::BeginChild("Categories"))
     {
-        std::set<std::string> categories;
-        for (const auto& [category, _] : registered_nodes)
-        {
-            categories.insert(category);
-        }
-
-        for (const auto& category : categories)
-        {
-            DrawPopupCategory(category, registered_nodes);
-        }
+        NodeSearch::ForEachCategory(matches, [this](const std::string& category, const auto& entries) {
+            DrawPopupCategory(category, entries);
+        });
 
         ImGui::EndChild();
     }
 }
 
-void NodeExplorerWindow::DrawPopupCategory(const std::string& category, const flow::CategoryMap& registered_nodes)
+void NodeExplorerWindow::DrawPopupCategory(const std::string& category,
+                                           std::span<const NodeSearch::Entry* const> entries)
 {
     if (!ImGui::TreeNodeEx(category.c_str(), node_lookup.empty() ? 0 : ImGuiTreeNodeFlags_DefaultOpen)) return;
 
-    auto [begin_it, end_it] = registered_nodes.equal_range(category);
-    for (auto it = begin_it; it != end_it; ++it)
+    for (const auto* entry : entries)
     {
-        const auto display_name = _env->GetFactory()->GetFriendlyName(it->second);
+        const auto& class_name = entry->second;
 
         ImGui::Bullet();
-        ImGui::Selectable(display_name.c_str());
+        ImGui::Selectable(_search.GetFriendlyName(*_env->GetFactory(), class_name).c_str());
 
         if (ImGui::BeginDragDropSource())
         {
-            const auto class_name = it->second;
             ImGui::Text("+ Create Node");
             ImGui::SetDragDropPayload("NewNode", class_name.c_str(), class_name.size() + 1, ImGuiCond_Once);
             ImGui::EndDragDropSource();
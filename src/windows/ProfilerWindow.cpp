@@ -0,0 +1,117 @@
+#include "ProfilerWindow.hpp"
+
+#include "FileExplorer.hpp"
+#include "Profiler.hpp"
+
+#include <imgui.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <numeric>
+
+FLOW_UI_NAMESPACE_START
+
+namespace
+{
+constexpr std::int64_t stats_interval = 1'000'000'000;
+constexpr double ns_per_ms            = 1e6;
+} // namespace
+
+ProfilerWindow::ProfilerWindow() : Window("Profiler") {}
+
+void ProfilerWindow::Draw()
+{
+#ifndef FLOW_UI_ENABLE_PROFILER
+    ImGui::TextUnformatted("Profiling is disabled, rebuild with flow-ui_ENABLE_PROFILER to enable it.");
+#else
+    auto& profiler = GetProfiler();
+
+    if (profiler.Now() - _last_update >= stats_interval)
+    {
+        UpdateStats();
+    }
+
+    const auto& frame_times = profiler.GetFrameTimes();
+    const float max_time    = *std::max_element(frame_times.begin(), frame_times.end());
+    const float avg_time =
+        std::accumulate(frame_times.begin(), frame_times.end(), 0.f) / static_cast<float>(frame_times.size());
+
+    ImGui::Text("Frame: %.2f ms avg, %.2f ms max", avg_time, max_time);
+    ImGui::PlotLines("##FrameTimes", frame_times.data(), static_cast<int>(frame_times.size()),
+                     static_cast<int>(profiler.GetFrameOffset()), nullptr, 0.f, std::max(max_time, 1.f),
+                     ImVec2(-1.f, 80.f));
+
+    ImGui::SetNextItemWidth(100.f);
+    ImGui::InputInt("Seconds", &_export_seconds);
+    _export_seconds = std::clamp(_export_seconds, 1, 60);
+
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace"))
+    {
+        const auto trace = profiler.ExportChromeTrace(static_cast<double>(_export_seconds));
+        const auto path  = FileExplorer::Save(FileExplorer::GetDownloadsPath() / "flow-ui.trace.json", trace);
+        if (!path.empty()) SPDLOG_INFO("Saved profiler trace to '{0}'", path.string());
+    }
+
+    if (!ImGui::BeginTable("Scopes", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY))
+    {
+        return;
+    }
+
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("Calls/Frame");
+    ImGui::TableSetupColumn("ms/Frame");
+    ImGui::TableSetupColumn("Avg (ms)");
+    ImGui::TableSetupColumn("Max (ms)");
+    ImGui::TableHeadersRow();
+
+    const double frames = static_cast<double>(std::max<std::size_t>(_frames, 1));
+    for (const auto& stats : _stats)
+    {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(stats.Name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.1f", static_cast<double>(stats.Calls) / frames);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", static_cast<double>(stats.Total) / ns_per_ms / frames);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", static_cast<double>(stats.Total) / ns_per_ms / static_cast<double>(stats.Calls));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", static_cast<double>(stats.Max) / ns_per_ms);
+    }
+
+    ImGui::EndTable();
+#endif
+}
+
+void ProfilerWindow::UpdateStats()
+{
+    auto& profiler = GetProfiler();
+    const auto now = profiler.Now();
+
+    _stats.clear();
+    _frames = 0;
+
+    // Scope names are interned, so names can be compared by pointer.
+    profiler.Visit(now - stats_interval, [&](const ProfileEvent& event) {
+        if (std::string_view(event.Name) == "Frame") ++_frames;
+
+        auto found = std::find_if(_stats.begin(), _stats.end(), [&](const auto& s) { return s.Name == event.Name; });
+        if (found == _stats.end())
+        {
+            found = _stats.insert(_stats.end(), ScopeStats{.Name = event.Name});
+        }
+
+        const auto duration = event.End - event.Start;
+        found->Calls++;
+        found->Total += duration;
+        found->Max = std::max(found->Max, duration);
+    });
+
+    std::sort(_stats.begin(), _stats.end(), [](const auto& a, const auto& b) { return a.Total > b.Total; });
+    _last_update = now;
+}
+
+FLOW_UI_NAMESPACE_END
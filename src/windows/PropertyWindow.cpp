@@ -3,22 +3,23 @@
 
 #include "PropertyWindow.hpp"
 
+#include <flow/ui/Profiler.hpp>
+#include <flow/ui/ValueFormatter.hpp>
 #include <flow/ui/widgets/PropertyTree.hpp>
 #include <flow/ui/widgets/Text.hpp>
+#include <flow/ui/widgets/TextViewer.hpp>
 #include <flow/ui/windows/GraphWindow.hpp>
 #include <imgui.h>
-#include <imgui_node_editor.h>
 
-#include <array>
-#include <set>
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 FLOW_UI_NAMESPACE_START
 
-using namespace ax;
-namespace ed = ax::NodeEditor;
-
 constexpr Colour empty_property_text_colour = Colour(175, 175, 175);
 
 struct CentredText : public widgets::Text
@@ -31,76 +32,201 @@ struct CentredText : public widgets::Text
     virtual ~CentredText() = default;
 };
 
-PropertyWindow::PropertyWindow(std::shared_ptr<flow::Env> env) : Window(PropertyWindow::Name), _env{env} {}
+/**
+ * @brief Text cell showing the data of a port, only re-formatted after the port data has changed.
+ */
+struct PortValueText : public widgets::Text
+{
+    PortValueText(const flow::UUID& node, const flow::SharedPort& port, bool is_output)
+        : Text("..."), _port{port}, _key{node, port->GetKey(), is_output}, _viewer("##value")
+    {
+        GetValueFormatter().Acquire(_key);
+    }
+
+    virtual ~PortValueText() { GetValueFormatter().Release(_key); }
 
-struct NodeProperty
+    virtual void operator()() noexcept override
+    {
+        auto& formatter = GetValueFormatter();
+
+        // Setting an input raises no event, so input cells compare the port's data whenever they are drawn instead.
+        const bool dirty = _dirty.exchange(false, std::memory_order_acq_rel);
+        if (dirty || !_key.IsOutput)
+        {
+            if (auto port = _port.lock())
+            {
+                auto data = port->GetData();
+                if (dirty || _requested.lock() != data)
+                {
+                    _requested = data;
+                    formatter.Request(_key, data, port->GetDataType());
+                }
+            }
+        }
+
+        if (auto value = formatter.Get(_key); value && value != _value)
+        {
+            _value = std::move(value);
+            SetText(std::string{_value->Preview()} + (_value->IsTruncated() ? "..." : ""));
+            _viewer.SetValue(_value);
+            _viewer_label = "Show all (" + std::to_string(_value->LineCount) + " lines, " +
+                            std::to_string(_value->Text.size()) + " bytes)";
+        }
+
+        Text::operator()();
+
+        // The complete value opens in a popup, so the cell keeps the single line height the property tree clips by.
+        if (_value && _value->IsTruncated())
+        {
+            ImGui::SameLine();
+            if (ImGui::SmallButton(_viewer_label.c_str())) ImGui::OpenPopup("##viewer");
+
+            ImGui::SetNextWindowSizeConstraints(ImVec2(400.f, 0.f), ImVec2(FLT_MAX, FLT_MAX));
+            if (ImGui::BeginPopup("##viewer"))
+            {
+                _viewer();
+                ImGui::EndPopup();
+            }
+        }
+    }
+
+    void MarkDirty() noexcept { _dirty.store(true, std::memory_order_release); }
+
+  private:
+    std::weak_ptr<flow::Port> _port;
+    ValuePortKey _key;
+    std::weak_ptr<flow::NodeData> _requested;
+    std::atomic_bool _dirty = true;
+
+    std::shared_ptr<const FormattedValue> _value;
+    widgets::TextViewer _viewer;
+    std::string _viewer_label;
+};
+
+struct PropertyWindow::NodeProperties
 {
-    std::string Name;
-    flow::SharedNode Node;
+    NodeProperties(const flow::SharedNode& node)
+        : Node{node}, Properties(node->GetName() + "##" + std::to_string(std::hash<flow::UUID>{}(node->ID())), 2)
+    {
+    }
+
+    std::weak_ptr<flow::Node> Node;
+    widgets::PropertyTree Properties;
+    std::unordered_map<flow::IndexableName, std::shared_ptr<PortValueText>> OutputValues;
 };
 
+PropertyWindow::PropertyWindow(std::shared_ptr<flow::Env> env) : Window(PropertyWindow::Name), _env{env} {}
+
+PropertyWindow::~PropertyWindow() { ClearProperties(); }
+
+void PropertyWindow::SetCurrentGraph(const std::shared_ptr<GraphWindow>& graph_window)
+{
+    if (_graph_window.lock() == graph_window) return;
+
+    _graph_window  = graph_window;
+    _needs_rebuild = true;
+}
+
 void PropertyWindow::Draw()
 {
     auto env = _env.lock();
     if (!env) return;
 
-    auto graph = _graph.lock();
-    if (!GetEditorContext() || !graph)
+    auto graph_window = _graph_window.lock();
+    if (!graph_window)
     {
+        ClearProperties();
         CentredText("Nothing to show", empty_property_text_colour)();
         return;
     }
 
-    ed::SetCurrentEditor(std::bit_cast<ed::EditorContext*>(GetEditorContext().get()));
-
-    std::array<ed::NodeId, 256> selected_ids;
-    auto result = ed::GetSelectedNodes(selected_ids.data(), 256);
-
-    if (result == 0)
+    if (graph_window->GetSelectedNodes().empty())
     {
+        ClearProperties();
         CentredText("Select one or more nodes", empty_property_text_colour)();
         return;
     }
 
-    std::set<ed::NodeId> ids(selected_ids.begin(), std::next(selected_ids.begin(), result));
+    if (_needs_rebuild || _selection_version != graph_window->GetSelectionVersion())
+    {
+        Rebuild(*graph_window);
+    }
 
-    std::vector<flow::SharedNode> nodes;
-    nodes.reserve(result);
+    for (auto& node_properties : _node_properties)
+    {
+        node_properties->Properties();
+    }
+}
+
+void PropertyWindow::Rebuild(const GraphWindow& graph_window)
+{
+    FLOW_UI_PROFILE_SCOPE("PropertyWindow::Rebuild");
 
-    graph->Visit([&](auto& node) {
-        if (!ids.contains(std::hash<flow::UUID>{}(node->ID()))) return;
-        nodes.emplace_back(node);
-    });
+    ClearProperties();
+    _needs_rebuild     = false;
+    _selection_version = graph_window.GetSelectionVersion();
 
-    for (auto& node : nodes)
+    const auto& selected_nodes = graph_window.GetSelectedNodes();
+    for (const auto& id : graph_window.GetSelectedIDs())
     {
+        auto found = selected_nodes.find(id);
+        if (found == selected_nodes.end()) continue;
 
-        std::string c_name = node->GetName() + "##" + std::to_string(std::hash<flow::UUID>{}(node->ID()));
-        widgets::PropertyTree properties(c_name, 2);
+        const auto& node     = found->second;
+        auto node_properties = std::make_shared<NodeProperties>(node);
 
-        const auto make_port_data_property = [&](const auto& port) -> std::vector<std::shared_ptr<flow::ui::Widget>> {
-            return {
+        const auto make_port_data_property = [&](const auto& port, const std::shared_ptr<PortValueText>& value) {
+            return std::vector<std::shared_ptr<flow::ui::Widget>>{
                 std::make_shared<widgets::Text>("Type"),
                 std::make_shared<widgets::Text>(std::string{port->GetDataType()}),
                 std::make_shared<widgets::Text>("Value"),
-                std::make_shared<widgets::Text>(port->GetData() ? port->GetData()->ToString() : "None"),
+                value,
             };
         };
 
         for (const auto& [key, input] : node->GetInputPorts())
         {
             const std::string key_name{std::string_view(key)};
-            properties.AddProperty(key_name, make_port_data_property(input), "Inputs");
+            auto value = std::make_shared<PortValueText>(node->ID(), input, false);
+            node_properties->Properties.AddProperty(key_name, make_port_data_property(input, value), "Inputs");
         }
 
         for (const auto& [key, output] : node->GetOutputPorts())
         {
             const std::string key_name{std::string_view(key)};
-            properties.AddProperty(key_name, make_port_data_property(output), "Outputs");
+            auto value = std::make_shared<PortValueText>(node->ID(), output, true);
+            node_properties->Properties.AddProperty(key_name, make_port_data_property(output, value), "Outputs");
+            node_properties->OutputValues.emplace(key, std::move(value));
         }
 
-        properties();
+        // Nodes compute off the UI thread, so the handler only flags the affected cell and the new value is passed to
+        // the value formatter the next time the cell is drawn.
+        node->OnSetOutput.Bind("PropertyWindow", [weak_properties = std::weak_ptr{node_properties}](
+                                                     const flow::IndexableName& key, auto) {
+            if (auto properties = weak_properties.lock())
+            {
+                if (auto it = properties->OutputValues.find(key); it != properties->OutputValues.end())
+                {
+                    it->second->MarkDirty();
+                }
+            }
+        });
+
+        _node_properties.emplace_back(std::move(node_properties));
+    }
+}
+
+void PropertyWindow::ClearProperties()
+{
+    for (const auto& node_properties : _node_properties)
+    {
+        if (auto node = node_properties->Node.lock())
+        {
+            node->OnSetOutput.Unbind("PropertyWindow");
+        }
     }
+
+    _node_properties.clear();
 }
 
 FLOW_UI_NAMESPACE_END
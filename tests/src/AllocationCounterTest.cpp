@@ -0,0 +1,101 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include <flow/ui/AllocationCounter.hpp>
+#include <flow/ui/FrameArena.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+FLOW_UI_COUNT_ALLOCATIONS()
+
+using namespace flow::ui;
+
+namespace
+{
+int failures = 0;
+
+void Check(bool condition, const char* description)
+{
+    if (condition) return;
+
+    std::cerr << "FAILED: " << description << '\n';
+    ++failures;
+}
+
+constexpr std::size_t settle_frames = 2;
+
+void ReportsSteadyStateAllocations()
+{
+    std::vector<std::size_t> regressions;
+    regressions.reserve(16);
+
+    AllocationCounter counter(settle_frames);
+    counter.SetRegressionHandler([&](std::size_t count) { regressions.push_back(count); });
+
+    auto allocate = [] { return std::make_unique<int>(0); };
+
+    allocate();
+    Check(counter.EndFrame(false) >= 1, "allocations are counted");
+
+    for (std::size_t i = 0; i < settle_frames; ++i)
+    {
+        allocate();
+        counter.EndFrame(true);
+    }
+    Check(regressions.empty(), "steady frames may allocate while settling");
+
+    counter.EndFrame(true);
+    Check(regressions.empty(), "settled frames without allocations pass");
+
+    allocate();
+    counter.EndFrame(true);
+    Check(regressions.size() == 1 && regressions.front() >= 1, "a settled frame that allocates is reported");
+
+    allocate();
+    counter.EndFrame(false);
+    Check(regressions.size() == 1, "frames that are not steady are not reported");
+}
+
+// Temporaries drawn from the frame arena stop reaching the heap once the arena has grown to fit a frame.
+void FrameArenaSettlesWithoutAllocating()
+{
+    std::vector<std::size_t> regressions;
+    regressions.reserve(16);
+
+    FrameArena arena(64);
+    AllocationCounter counter(settle_frames);
+    counter.SetRegressionHandler([&](std::size_t count) { regressions.push_back(count); });
+
+    for (std::size_t frame = 0; frame < settle_frames + 8; ++frame)
+    {
+        arena.Reset();
+
+        FrameVector<int> values(&arena);
+        for (int i = 0; i < 256; ++i)
+        {
+            values.push_back(i);
+        }
+
+        FrameString text("a temporary string that is too long for the small string buffer", &arena);
+        Check(values.size() == 256 && !text.empty(), "frame temporaries hold their values");
+
+        counter.EndFrame(true);
+    }
+
+    Check(regressions.empty(), "a settled frame arena does not allocate");
+}
+} // namespace
+
+int main()
+{
+    ReportsSteadyStateAllocations();
+    FrameArenaSettlesWithoutAllocating();
+
+    if (failures > 0) return EXIT_FAILURE;
+
+    std::cout << "All allocation counter tests passed\n";
+    return EXIT_SUCCESS;
+}
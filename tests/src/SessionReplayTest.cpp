@@ -0,0 +1,89 @@
+// Copyright (c) 2024, Cisco Systems, Inc.
+// All rights reserved.
+
+#include <flow/ui/SessionRecorder.hpp>
+#include <imgui.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+
+using namespace flow::ui;
+
+namespace
+{
+int failures = 0;
+
+void Check(bool condition, const char* description)
+{
+    if (condition) return;
+
+    std::cerr << "FAILED: " << description << '\n';
+    ++failures;
+}
+
+void StepFrame()
+{
+    ImGui::NewFrame();
+    ImGui::EndFrame();
+}
+
+RecordedInput MouseButton(bool down)
+{
+    return RecordedInput{.Type = RecordedInput::Kind::MouseButton, .Code = ImGuiMouseButton_Left, .Down = down};
+}
+
+// A click recorded in a single frame is trickled over two frames by ImGui, so the release has to survive the
+// replayer dropping live input on the next frame.
+void ReplaysClickWithinOneFrame()
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGuiIO& io       = ImGui::GetIO();
+    io.DisplaySize    = ImVec2(800.f, 600.f);
+    io.Fonts->Build();
+
+    SessionRecording recording;
+    recording.Frames.push_back(RecordedFrame{
+        .DeltaTime = 1.f / 60.f,
+        .Events =
+            {
+                RecordedInput{.Type = RecordedInput::Kind::MousePos, .X = 10.f, .Y = 10.f},
+                MouseButton(true),
+                MouseButton(false),
+            },
+    });
+    recording.Frames.push_back(RecordedFrame{.DeltaTime = 1.f / 60.f});
+
+    {
+        SessionReplayer replayer(ctx, std::move(recording), ReplayPace::Unthrottled);
+
+        ImGui::NewFrame();
+        Check(ImGui::IsMouseClicked(ImGuiMouseButton_Left), "mouse is clicked on the first frame");
+        Check(!ImGui::IsMouseReleased(ImGuiMouseButton_Left), "mouse is not released on the first frame");
+        ImGui::EndFrame();
+
+        // Live input queued between frames is dropped in favour of the replay.
+        io.AddMouseButtonEvent(ImGuiMouseButton_Right, true);
+
+        ImGui::NewFrame();
+        Check(ImGui::IsMouseReleased(ImGuiMouseButton_Left), "mouse is released on the second frame");
+        Check(!ImGui::IsMouseDown(ImGuiMouseButton_Right), "live input is dropped");
+        ImGui::EndFrame();
+
+        StepFrame();
+        Check(replayer.IsFinished(), "replay finishes after the recorded frames");
+    }
+
+    ImGui::DestroyContext(ctx);
+}
+} // namespace
+
+int main()
+{
+    ReplaysClickWithinOneFrame();
+
+    if (failures > 0) return EXIT_FAILURE;
+
+    std::cout << "All session replay tests passed\n";
+    return EXIT_SUCCESS;
+}